@@ -27,6 +27,7 @@
 #include "Scenes/StartScene.h"  // Ϊ˵
 #include "Managers/AudioManager.h"
 #include "Managers/SceneManager.h"
+#include "Sim/TraceWriter.h"
 
 // Ƶ
 #define USE_AUDIO_ENGINE 1
@@ -52,6 +53,8 @@ AppDelegate::~AppDelegate()
 #if USE_AUDIO_ENGINE
     AudioEngine::end();
 #endif
+    // Close the trace file (completes the JSON)
+    TraceWriter::getInstance().stop();
 }
 
 // if you want a different context, modify the value of glContextAttrs
@@ -72,6 +75,9 @@ static int register_all_packages()
 }
 
 bool AppDelegate::applicationDidFinishLaunching() {
+    // PVZ_TRACE=<file>: write a Chrome trace (on Linux also --trace <file>)
+    TraceWriter::getInstance().startFromEnvironment();
+
     // initialize director
     auto director = Director::getInstance();
     auto glview = director->getOpenGLView();
@@ -19,10 +19,15 @@ Bullet* Bullet::create(const BulletData& data) {
 bool Bullet::init() {
     if (!Unit::init()) return false;
     _type = UnitType::BULLET;
-    _active = true;
     return true;
 }
 
+void Bullet::reset() {
+    Unit::reset();
+    _type = UnitType::BULLET;
+    _data = BulletData();
+}
+
 void Bullet::setBulletData(const BulletData& data) {
     _data = data;
 
@@ -39,8 +44,8 @@ void Bullet::setBulletData(const BulletData& data) {
                 snprintf(defaultPath, sizeof(defaultPath), _data.animationConfig.frameFormat.c_str(), 1);
                 firstFramePath = defaultPath;
             }
-            if (!firstFramePath.empty() && FileUtils::getInstance()->isFileExist(firstFramePath)) {
-                this->setTexture(firstFramePath);
+            if (_data.animationConfig.inAtlas || (!firstFramePath.empty() && FileUtils::getInstance()->isFileExist(firstFramePath))) {
+                AnimationHelper::setFirstFrame(this, _data.animationConfig, firstFramePath);
             }
             
             // Run animation
@@ -69,17 +74,3 @@ void Bullet::setBulletData(const BulletData& data) {
     }
 }
 }
-
-void Bullet::updateLogic(float dt) {
-    if (!_active) return;
-
-    // Bullet moves to the right
-    float moveDist = _data.speed * dt;
-    this->setPositionX(this->getPositionX() + moveDist);
-
-    // Out of bounds check (screen width is 1280)
-    if (this->getPositionX() > 1300) {
-        this->removeFromParent();
-        _active = false;
-    }
-}
\ No newline at end of file
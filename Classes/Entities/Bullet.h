@@ -9,27 +9,16 @@
 class Bullet : public Unit {
 public:
     static Bullet* create(const BulletData& data);
+    CREATE_FUNC(Bullet);  // empty bullet for EntityPool, call setBulletData() after acquire()
     virtual bool init() override;
-    virtual void updateLogic(float dt) override;
 
-    void setBulletData(const BulletData& data);
-
-    // ��ȡ�˺�ֵ
-    int getDamage() const { return _data.damage; }
+    virtual void reset() override;
 
-    // ��ȡ�ӵ�����
-    BulletType getType() const { return _data.type; }
-    
-    // ��ȡ����Ч������
-    float getSlowEffect() const { return _data.slowEffect; }
-
-    // ����ӵ��Ƿ��Ѿ����У���ֹһ�δ�͸������ˣ�
-    bool isActive() const { return _active; }
-    void deactivate() { _active = false; }
+    // Appearance only: movement and hits are handled by Simulation
+    void setBulletData(const BulletData& data);
 
 private:
     BulletData _data;
-    bool _active = true;
 };
 
-#endif // __BULLET_H__
\ No newline at end of file
+#endif // __BULLET_H__
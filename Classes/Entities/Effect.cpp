@@ -0,0 +1,15 @@
+// 实现特效精灵
+// 2026.10.17 by BillyDu
+#include "Effect.h"
+
+USING_NS_CC;
+
+void Effect::reset() {
+    this->stopAllActions();
+    this->removeAllChildren();
+    this->setColor(Color3B::WHITE);
+    this->setOpacity(255);
+    this->setScale(1.0f);
+    this->setRotation(0.0f);
+    this->setVisible(true);
+}
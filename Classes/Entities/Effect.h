@@ -0,0 +1,16 @@
+// 特效精灵（爆炸等一次性动画），可放入 EntityPool 复用
+// 2026.10.17 by BillyDu
+#ifndef __EFFECT_H__
+#define __EFFECT_H__
+
+#include "cocos2d.h"
+
+class Effect : public cocos2d::Sprite {
+public:
+    CREATE_FUNC(Effect);
+
+    // 恢复为刚创建时的状态（回收到对象池后再次取出时调用）
+    void reset();
+};
+
+#endif // __EFFECT_H__
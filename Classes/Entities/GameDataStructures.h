@@ -14,12 +14,64 @@ struct AnimationConfig {
     int loopCount = -1;        // 循环次数：-1表示无限循环，1表示播放一次
     std::string defaultTexture; // 默认纹理（通常是第一帧）
     std::string onComplete;     // 动画完成后的行为："idle", "remove", "none"
+    bool inAtlas = false;       // 所有帧都已由图集载入 SpriteFrameCache（DataManager 解析时设置）
+    std::string cacheKey;       // AnimationCache 键（DataManager 解析时生成，见 AnimationHelper::makeCacheKey）
+};
+
+// Projectile kinds; the view maps each kind to its BulletData / textures
+enum class ProjectileKind {
+    PEA,
+    ICE_PEA,
+    MUSHROOM
+};
+
+// Explosion kinds: boom1 = CherryBomb (3x3), boom2 = PotatoMine (same row)
+enum class ExplosionKind {
+    CHERRY_BOMB,
+    POTATO_MINE
+};
+
+// 植物分类（plants.json 的 "type"），加载时转成枚举
+enum class PlantCategory {
+    UNKNOWN,
+    SHOOTER,
+    PRODUCER,
+    INSTANT,
+    DEFENSIVE,
+    SUPPORT
+};
+
+// 植物行为（plants.json 的 "behavior.kind"），模拟按它查表分派
+enum class PlantBehaviorKind {
+    NONE,       // 只会挨打（WallNut、TallNut）
+    SHOOTER,    // 每 attackSpeed 秒向前方发射子弹
+    PRODUCER,   // 每 attackSpeed 秒产出阳光
+    SPIKES,     // 伤害本格内的僵尸，不能被啃
+    BOMB,       // 种下后引信结束即爆炸（CherryBomb）
+    MINE,       // 被啃或被碾压时爆炸（PotatoMine）
+    EATER,      // 整只吞下僵尸后消化（Chomper）
+    PLATFORM,   // 水面平台，其他植物种在上面（LilyPad）
+    COUNT
+};
+
+// 行为参数，只有对应行为用到的字段有意义
+struct PlantBehavior {
+    PlantBehaviorKind kind = PlantBehaviorKind::NONE;
+    ProjectileKind projectile = ProjectileKind::PEA;   // SHOOTER: 子弹类型
+    int volley = 1;                                     // SHOOTER: 每次发射的子弹数（Repeater 为 2）
+    float volleyDelay = 0.05f;                          // SHOOTER: 同一轮子弹之间的间隔
+    ExplosionKind aoe = ExplosionKind::CHERRY_BOMB;     // BOMB / MINE: 爆炸范围
+    float fuse = 0.1f;                                  // BOMB: 种下到爆炸的时间
+    float eatCooldown = 30.0f;                          // EATER: 消化时间
+    int crushDamage = 0;                                // SPIKES: 被 Boss2 碾过时对它造成的伤害
 };
 
 // 植物的基本数据结构
 struct PlantData {
     std::string name;
     std::string type;     // "shooter" or "producer"
+    PlantCategory category = PlantCategory::UNKNOWN;   // type 转换后的枚举
+    PlantBehavior behavior;
     int hp = 0;
     int cost = 0;
     float cooldown = 0.0f;
@@ -40,6 +92,7 @@ struct ZombieData {
     int damage = 0;
     float speed = 0.0f;          // �ƶ��ٶ�
     float attackInterval = 1.0f; // �������
+    float hitWidth = 166.0f;     // Collision box width (matches the walk frame width)
     std::string texturePath;
     
     // �������ã��������� -> ��������
@@ -47,6 +100,14 @@ struct ZombieData {
     std::string defaultAnimation; // Ĭ�϶������ƣ��� "walk"
 };
 
+// One entry of a level's spawn timeline
+struct SpawnEvent {
+    float time;
+    int zombieId;
+    int row;
+    bool spawned = false; // 是否已刷新
+};
+
 // �ӵ�����ö��
 enum class BulletType {
     NORMAL,  // ��ͨ�ӵ�
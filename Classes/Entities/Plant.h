@@ -4,7 +4,6 @@
 #ifndef __PLANT_H__
 #define __PLANT_H__
 
-#include <functional>
 #include <string>
 
 #include "Unit.h"
@@ -12,39 +11,29 @@
 
 class Plant : public Unit {
 public:
+    // data is shared (DataManager / SimDataSnapshot), not copied: it must outlive the plant
     static Plant* createWithData(const PlantData& data);
     virtual bool init() override;
 
     // 重写父类函数
-    virtual void updateLogic(float dt) override;
     virtual void die() override;
 
     // ֲ�������߼�
     void setPlantData(const PlantData& data);
 
-    // 触发技能，如发射豌豆、生产阳光等
-    virtual void triggerSkill();
+    // 攻击/生产计时与技能逻辑在 Simulation 中，Plant 只负责表现
 
-    // 设置发射子弹的回调：位置 (Vec2), 伤害 (int) - 也可以传 BulletData
-    void setOnShootCallback(const std::function<void(cocos2d::Vec2, int)>& callback);
-
-    // ���ü���Ƿ��й���Ŀ��Ļص�
-    void setHasTargetCallback(const std::function<bool()>& callback);
-    
     // ������ط���
     void playAnimation(const std::string& animName);  // ����ָ������
     void playDefaultAnimation();  // ����Ĭ�϶���
 
     // --- ֻ�������� ---
-    const std::string& getName() const { return _data.name; }
-    const std::string& getType() const { return _data.type; }
-    const PlantData& getData() const { return _data; }
+    const std::string& getName() const { return _data->name; }
+    const std::string& getType() const { return _data->type; }
+    const PlantData& getData() const { return *_data; }
 
 protected:
-    PlantData _data;
-    float _timer; // 用于攻击/生产间隔的计时器
-    std::function<void(cocos2d::Vec2, int)> _onShootCallback;
-    std::function<bool()> _hasTargetCallback;  // ����Ƿ��й���Ŀ��Ļص�
+    const PlantData* _data = nullptr;
     std::string _currentAnimation;  // ��ǰ���ŵĶ�������
 };
 
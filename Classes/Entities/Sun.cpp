@@ -28,8 +28,7 @@ bool Sun::init() {
 
         Vec2 p = this->getParent()->convertToNodeSpace(t->getLocation());
         if (this->getBoundingBox().containsPoint(p)) {
-            this->collect();
-            return true;
+            return this->collect();
         }
         return false;
         };
@@ -41,7 +40,20 @@ bool Sun::init() {
     return true;
 }
 
-void Sun::setOnCollectedCallback(const std::function<void(int)>& callback) {
+void Sun::reset() {
+    this->stopAllActions();
+    this->setOpacity(255);
+    this->setScale(1.0f);
+    this->setRotation(0.0f);
+    this->setVisible(true);
+    _isCollected = false;
+    _onCollectedCallback = nullptr;
+    _value = 25;
+
+    this->runAction(RepeatForever::create(RotateBy::create(3.0f, 360)));
+}
+
+void Sun::setOnCollectedCallback(const std::function<bool(int)>& callback) {
     _onCollectedCallback = callback;
 }
 
@@ -49,13 +61,9 @@ void Sun::fallFromSky(float startX, float targetY) {
     this->setPosition(startX, Director::getInstance()->getVisibleSize().height + 50); // ��Ļ�Ϸ�
     this->setVisible(true);
 
-    // ���������� -> ͣ��һ��ʱ�� -> ��ʧ
+    // 只负责下落；停留多久由 Simulation 按模拟时间决定，到期后 GameScene 调用 expire()
     auto move = MoveTo::create(5.0f, Vec2(startX, targetY)); // 3�����ٵ���
-    auto delay = DelayTime::create(3.0f); // ���ϴ�5��
-    auto fadeOut = FadeOut::create(1.0f);
-    auto remove = RemoveSelf::create();
-
-    this->runAction(Sequence::create(move, delay, fadeOut, remove, nullptr));
+    this->runAction(move);
 }
 
 void Sun::jumpFromPlant(Vec2 startPos, Vec2 targetPos) {
@@ -72,17 +80,24 @@ void Sun::jumpFromPlant(Vec2 startPos, Vec2 targetPos) {
     auto scale = ScaleTo::create(0.5f, 1.0f);
     auto spawn = Spawn::create(jump, scale, nullptr);
 
-    auto delay = DelayTime::create(5.0f);
-    auto fadeOut = FadeOut::create(1.0f);
-    auto remove = RemoveSelf::create();
+    this->runAction(spawn);
+}
 
-    this->runAction(Sequence::create(spawn, delay, fadeOut, remove, nullptr));
+void Sun::expire() {
+    _isCollected = true; // 淡出期间不再响应点击
+    this->runAction(Sequence::create(FadeOut::create(1.0f), RemoveSelf::create(), nullptr));
 }
 
-void Sun::collect() {
+bool Sun::collect() {
+    // Credit the sun right away so it cannot expire while flying to the corner
+    if (_onCollectedCallback && !_onCollectedCallback(_value)) {
+        return false; // already expired in the simulation
+    }
     _isCollected = true;
     this->stopAllActions(); // ֹͣ�������ʧ����
 
+    CCLOG("[Info] Sun Collected! +%d", _value);
+
     // �������������Ͻ� (UI �����λ�� 20, 680)
     // ע�⣺�����������ô� GameScene ����������ʱд��
     Vec2 targetUI = Vec2(40, Director::getInstance()->getVisibleSize().height - 40);
@@ -91,13 +106,6 @@ void Sun::collect() {
     auto scale = ScaleTo::create(0.5f, 0.3f); // ��С
     auto spawn = Spawn::create(move, scale, nullptr);
 
-    auto callback = CallFunc::create([this]() {
-        if (_onCollectedCallback) {
-            _onCollectedCallback(_value);
-        }
-        CCLOG("[Info] Sun Collected! +%d", _value);
-        this->removeFromParent();
-        });
-
-    this->runAction(Sequence::create(spawn, callback, nullptr));
+    this->runAction(Sequence::create(spawn, RemoveSelf::create(), nullptr));
+    return true;
 }
\ No newline at end of file
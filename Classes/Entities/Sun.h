@@ -11,8 +11,15 @@ public:
     static Sun* create();
     virtual bool init() override;
 
-    // �����ռ��ص��������ɵ����ϽǺ���ã�
-    void setOnCollectedCallback(const std::function<void(int)>& callback);
+    // Back to a freshly created state for EntityPool reuse (the touch listener is kept)
+    void reset();
+
+    // Called as soon as the sun is clicked; returns false if the simulation no longer has
+    // this sun, in which case the click is ignored. The fly-to-corner animation is cosmetic
+    void setOnCollectedCallback(const std::function<bool(int)>& callback);
+
+    // The simulation expired this sun: fade out and leave the scene (the pool reclaims it)
+    void expire();
 
     // ����ģʽ 1: �������
     // targetY: ���䵽�ĵ���߶�
@@ -23,10 +30,10 @@ public:
 
 private:
     // �������ռ��߼�
-    void collect();
+    bool collect();
 
     bool _isCollected = false; // ��ֹ�ظ����
-    std::function<void(int)> _onCollectedCallback;
+    std::function<bool(int)> _onCollectedCallback;
     int _value = 25; // һ����� 25 ��
 };
 
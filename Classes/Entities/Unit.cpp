@@ -27,6 +27,14 @@ void Unit::takeDamage(int damage) {
     if (isDead()) return;
 
     _hp -= damage;
+    playHitEffect();
+
+    if (_hp <= 0) {
+        die();
+    }
+}
+
+void Unit::playHitEffect() {
     // �򵥵��ܻ����������һ��
     this->setColor(Color3B::RED);
     // ʹ�� Lambda �ӳٻָ���ɫ (C++11)
@@ -35,10 +43,21 @@ void Unit::takeDamage(int damage) {
         this->setColor(Color3B::WHITE);
         });
     this->runAction(Sequence::create(delay, restore, nullptr));
+}
 
-    if (_hp <= 0) {
-        die();
-    }
+void Unit::reset() {
+    this->stopAllActions();
+    this->removeAllChildren();
+    this->setColor(Color3B::WHITE);
+    this->setOpacity(255);
+    this->setScale(1.0f);
+    this->setRotation(0.0f);
+    this->setVisible(true);
+
+    _row = -1;
+    _state = UnitState::IDLE;
+    _hp = 0;
+    _maxHp = 0;
 }
 
 void Unit::die() {
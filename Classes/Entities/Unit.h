@@ -33,6 +33,12 @@ public:
     // �ܵ��˺�
     virtual void takeDamage(int damage);
 
+    // Hit flash (briefly tint red); also used by the view when the Simulation reports damage
+    void playHitEffect();
+
+    // Back to a freshly created state (stop actions, drop children, clear tint / state) for EntityPool reuse
+    virtual void reset();
+
     // �����߼� (���Ŷ������Ƴ��Լ���)
     virtual void die();
 
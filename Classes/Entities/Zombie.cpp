@@ -25,34 +25,40 @@ bool Zombie::init() {
 
     _type = UnitType::ZOMBIE;
     _state = UnitState::WALK;
-    _attackTimer = 0.0f;
-    _lifeTimer = 0.0f;  // Initialize life timer
     _currentAnimation = "";
 
     return true;
 }
 
+void Zombie::reset() {
+    Unit::reset();
+    _type = UnitType::ZOMBIE;
+    _state = UnitState::WALK;
+    _currentAnimation.clear();
+    _data = nullptr;
+}
+
 // ����ע���߼�
 void Zombie::setZombieData(const ZombieData& data) {
-    _data = data;
+    _data = &data;
 
     // 1. Set HP
     this->setHp(data.hp);
 
     // 2. Use animation if available, otherwise use static texture
-    if (!_data.animations.empty() && !_data.defaultAnimation.empty()) {
+    if (!_data->animations.empty() && !_data->defaultAnimation.empty()) {
         // Has animation config, play default animation
-        CCLOG("[Info] Zombie %s: Loading animation '%s'", _data.name.c_str(), _data.defaultAnimation.c_str());
+        CCLOG("[Info] Zombie %s: Loading animation '%s'", _data->name.c_str(), _data->defaultAnimation.c_str());
         playDefaultAnimation();
-    } else if (!_data.texturePath.empty()) {
+    } else if (!_data->texturePath.empty()) {
         // No animation config, use static texture
-        CCLOG("[Info] Zombie %s: Using static texture: %s", _data.name.c_str(), _data.texturePath.c_str());
-            this->setTexture(_data.texturePath);
+        CCLOG("[Info] Zombie %s: Using static texture: %s", _data->name.c_str(), _data->texturePath.c_str());
+            this->setTexture(_data->texturePath);
     } else {
         // Fallback
         this->setTextureRect(Rect(0, 0, 60, 90));
         this->setColor(Color3B::RED);
-        CCLOG("[Warn] Zombie %s used fallback color block.", _data.name.c_str());
+        CCLOG("[Warn] Zombie %s used fallback color block.", _data->name.c_str());
     }
 }
 
@@ -63,9 +69,9 @@ void Zombie::playAnimation(const std::string& animName) {
     }
     
     // Find animation config
-    auto it = _data.animations.find(animName);
-    if (it == _data.animations.end()) {
-        CCLOG("[Warn] Animation '%s' not found for zombie %s", animName.c_str(), _data.name.c_str());
+    auto it = _data->animations.find(animName);
+    if (it == _data->animations.end()) {
+        CCLOG("[Warn] Animation '%s' not found for zombie %s", animName.c_str(), _data->name.c_str());
         return;
     }
     
@@ -86,7 +92,7 @@ void Zombie::playAnimation(const std::string& animName) {
             firstFramePath = defaultPath;
         }
         if (!firstFramePath.empty()) {
-            this->setTexture(firstFramePath);
+            AnimationHelper::setFirstFrame(this, animConfig, firstFramePath);
         }
         
         // Handle completion behavior based on animation type
@@ -116,161 +122,64 @@ void Zombie::playAnimation(const std::string& animName) {
         this->runAction(animate);
         _currentAnimation = animName;
     } else {
-        CCLOG("[Err] Failed to create animation '%s' for zombie %s", animName.c_str(), _data.name.c_str());
+        CCLOG("[Err] Failed to create animation '%s' for zombie %s", animName.c_str(), _data->name.c_str());
     }
 }
 
 void Zombie::playDefaultAnimation() {
-    if (!_data.defaultAnimation.empty()) {
-        playAnimation(_data.defaultAnimation);
-    } else if (!_data.animations.empty()) {
+    if (!_data->defaultAnimation.empty()) {
+        playAnimation(_data->defaultAnimation);
+    } else if (!_data->animations.empty()) {
         // If no default animation, use first animation
-        playAnimation(_data.animations.begin()->first);
-    }
-}
-
-void Zombie::checkPhaseTransition() {
-    if (_maxHp <= 0) return;
-    
-    int currentHp = getHp();
-    float hpPercent = (float)currentHp / (float)_maxHp * 100.0f;
-    
-    // Boss1: 30% threshold (move1/eat1 -> move2/eat2)
-    if (_data.name == "Boss1" && !_isPhase2) {
-        if (hpPercent <= 30.0f) {
-            _isPhase2 = true;
-            CCLOG("[Info] Boss1 entered Phase 2! HP: %.1f%% (%d/%d)", hpPercent, currentHp, _maxHp);
-            
-            // Switch animations based on current state
-            if (_state == UnitState::WALK) {
-                if (_currentAnimation == "move1") {
-                    playAnimation("move2");
-                }
-            }
-            else if (_state == UnitState::ATTACK) {
-                if (_currentAnimation == "eat1") {
-                    playAnimation("eat2");
-                }
-            }
-        }
-    }
-    // Boss2: Multi-phase transitions (75% -> move2, 40% -> move3, 20% -> move4)
-    else if (_data.name == "Boss2") {
-        int targetPhase = 1;
-        if (hpPercent <= 20.0f) {
-            targetPhase = 4;
-        }
-        else if (hpPercent <= 40.0f) {
-            targetPhase = 3;
-        }
-        else if (hpPercent <= 75.0f) {
-            targetPhase = 2;
-    }
-
-        if (targetPhase != _currentPhase) {
-            int oldPhase = _currentPhase;
-            _currentPhase = targetPhase;
-            std::string animName = "move" + std::to_string(targetPhase);
-            CCLOG("[Info] Boss2 phase transition: %d -> %d (HP: %.1f%%)", oldPhase, targetPhase, hpPercent);
-            playAnimation(animName);
-        }
+        playAnimation(_data->animations.begin()->first);
     }
 }
 
-void Zombie::updateLogic(float dt) {
-    Unit::updateLogic(dt);
+void Zombie::syncWithSim(const SimZombie& zombie, float alpha) {
+    this->setPosition(zombie.renderX(alpha), zombie.renderY(alpha));
 
-	_attackTimer += dt;
-    _lifeTimer += dt;  // Update life timer for walk1->walk2 transition
-    
-    // Check for phase transition (for boss zombies)
-    checkPhaseTransition();
-
-    // Boss2 (snow sled) always moves forward, never stops
-    if (_data.name == "Boss2") {
-        // Always use move animation based on current phase
-        std::string targetAnim = "move" + std::to_string(_currentPhase);
-        if (_currentAnimation != targetAnim) {
-            playAnimation(targetAnim);
-        }
-        
-        // Always move forward (crushing type, never stops)
-        float moveDist = _data.speed * _speedMultiplier * dt;
-        this->setPositionX(this->getPositionX() - moveDist);
-        
-        // Simple boundary check
-        if (this->getPositionX() < -50) {
-            this->removeFromParent();
-            CCLOG("[Info] Boss2 reached the house! Game Over?");
-			// TODO: Trigger game over logic
-        }
-        return; // Boss2 doesn't use normal attack logic
+    // Boss2 (snow sled) always uses the move animation of its current phase
+    if (zombie.isCrushing) {
+        playAnimation("move" + std::to_string(zombie.phase));
+        return;
     }
 
-    if (_state == UnitState::WALK) {
+    if (zombie.state == ZombieState::WALK) {
+        _state = UnitState::WALK;
         // For boss1, use move1/move2 instead of walk
-        if (_data.name == "Boss1") {
-            std::string targetAnim = _isPhase2 ? "move2" : "move1";
-            if (_currentAnimation != targetAnim) {
-                playAnimation(targetAnim);
-            }
+        if (zombie.isBoss1) {
+            playAnimation(zombie.phase == 2 ? "move2" : "move1");
         }
-        else {
-            // 普通僵尸：如果有 walk1/walk2，则先走10秒walk1，然后自动切换为walk2（游泳）
-            auto itWalk1 = _data.animations.find("walk1");
-            auto itWalk2 = _data.animations.find("walk2");
-            if (itWalk1 != _data.animations.end() && itWalk2 != _data.animations.end()) {
-                // 游泳僵尸：前10秒用walk1，10秒后自动切换为walk2
-                std::string targetAnim = (_lifeTimer >= 15.0f) ? "walk2" : "walk1";
-                if (_currentAnimation != targetAnim) {
-                    playAnimation(targetAnim);
-                }
-            } else {
-                // 普通只有一个 "walk" 动画的僵尸
-                if (_currentAnimation != "walk") {
-                    playAnimation("walk");
-                }
-            }
+        else if (_data->animations.count("walk1") && _data->animations.count("walk2")) {
+            // 游泳僵尸：前15秒用walk1，之后自动切换为walk2
+            playAnimation(zombie.walk2 ? "walk2" : "walk1");
         }
-        
-        // Move left (apply speed multiplier for slow effects)
-        float moveDist = _data.speed * _speedMultiplier * dt;
-        this->setPositionX(this->getPositionX() - moveDist);
-
-        // Simple boundary check
-        if (this->getPositionX() < -50) {
-            this->removeFromParent();
-            CCLOG("[Info] Zombie reached the house! Game Over?");
-			// TODO: Trigger game over logic
+        else {
+            // 普通只有一个 "walk" 动画的僵尸
+            playAnimation("walk");
         }
     }
-    else if (_state == UnitState::ATTACK) {
+    else if (zombie.state == ZombieState::ATTACK) {
+        _state = UnitState::ATTACK;
         // For boss1, use eat1/eat2 instead of eat
-        if (_data.name == "Boss1") {
-            std::string targetAnim = _isPhase2 ? "eat2" : "eat1";
-            if (_currentAnimation != targetAnim) {
-                playAnimation(targetAnim);
-            }
+        if (zombie.isBoss1) {
+            playAnimation(zombie.phase == 2 ? "eat2" : "eat1");
         }
         else {
-            // Normal zombies use "eat"
-            if (_currentAnimation != "eat") {
-                playAnimation("eat");
-            }
+            playAnimation("eat");
         }
-		// Attack logic is handled externally, here we only maintain state and animation
     }
 }
 
 void Zombie::die() {
-    CCLOG("Zombie %s died!", _data.name.c_str());
+    CCLOG("Zombie %s died!", _data->name.c_str());
     
     // For boss1 and boss2, use "die" animation
-    std::string deathAnim = ((_data.name == "Boss1") || (_data.name == "Boss2")) ? "die" : "dead";
+    std::string deathAnim = ((_data->name == "Boss1") || (_data->name == "Boss2")) ? "die" : "dead";
 
     // If has death animation, play it
-    auto deadIt = _data.animations.find(deathAnim);
-    if (deadIt != _data.animations.end()) {
+    auto deadIt = _data->animations.find(deathAnim);
+    if (deadIt != _data->animations.end()) {
         playAnimation(deathAnim);
     } else {
         // No death animation, directly call parent's die
@@ -278,24 +187,3 @@ void Zombie::die() {
     }
 }
 
-
-bool Zombie::canAttack() const {
-    // If current attack timer exceeds the configured attack interval, can attack
-    return _attackTimer >= _data.attackInterval;
-}
-
-void Zombie::resetAttackTimer() {
-    _attackTimer = 0.0f; // Reset, start cooldown
-}
-
-void Zombie::applySlowEffect(float speedMultiplier) {
-    // Apply slow effect (lower value = slower)
-    // Always apply the slow effect, even if it's the same or higher
-    // This ensures the effect is refreshed and visible
-    _speedMultiplier = speedMultiplier;
-    CCLOG("[Info] Zombie %s slowed to %.1f%% speed (original speed: %.1f, current speed: %.1f)", 
-          _data.name.c_str(), 
-          speedMultiplier * 100.0f,
-          _data.speed,
-          _data.speed * _speedMultiplier);
-}
\ No newline at end of file
@@ -6,51 +6,32 @@
 #include <string>
 #include "Unit.h"
 #include "GameDataStructures.h"
+#include "../Sim/SimTypes.h"
 
 class Zombie : public Unit {
 public:
     static Zombie* createWithData(const ZombieData& data);
+    CREATE_FUNC(Zombie);  // empty zombie for EntityPool, call setZombieData() after acquire()
     virtual bool init() override;
 
-    virtual void updateLogic(float dt) override;
+    virtual void reset() override;
+
     virtual void die() override;
 
+    // data is shared (the Simulation's archetype), not copied: it must outlive the zombie
     void setZombieData(const ZombieData& data);
 
-    // Check if can attack (cooldown ready)
-    bool canAttack() const;
-
-    // Reset attack timer
-    void resetAttackTimer();
-
-    // Get damage
-    int getDamage() const { return _data.damage; }
-
-    // Apply slow effect (speed multiplier, e.g., 0.5 for 50% speed)
-    void applySlowEffect(float speedMultiplier);
+    // Mirror the simulation state: position plus walk/eat/boss-phase animation
+    // alpha: 插值系数，位置取最近两次模拟状态之间（1 = 最新状态）
+    void syncWithSim(const SimZombie& zombie, float alpha = 1.0f);
     
     // Animation related methods
     void playAnimation(const std::string& animName);  // Play specified animation
     void playDefaultAnimation();  // Play default animation
 
-    // Check if this zombie is a crushing type (like Boss2 snow sled)
-    bool isCrushingType() const { return _data.name == "Boss2"; }
-    
-    // Get current phase for multi-phase bosses
-    int getCurrentPhase() const { return _currentPhase; }
-
 private:
-    ZombieData _data;
-	float _attackTimer = 0.0f;
-    float _lifeTimer = 0.0f;  // Timer to track zombie lifetime (for walk1->walk2 transition)
+    const ZombieData* _data = nullptr;
     std::string _currentAnimation;  // Current playing animation name
-    float _speedMultiplier = 1.0f;  // Current speed multiplier (1.0 = normal, 0.5 = slowed)
-    bool _isPhase2 = false;  // Track if boss has entered phase 2 (30% HP threshold for Boss1)
-    int _currentPhase = 1;   // Current phase for multi-phase bosses (Boss2: 1-4)
-    float _lastIceX = -1.0f; // Last X position where ice was placed (for Boss2)
-    
-    // Check and update phase based on HP threshold
-    void checkPhaseTransition();
 };
 
-#endif // __ZOMBIE_H__
\ No newline at end of file
+#endif // __ZOMBIE_H__
@@ -1,8 +1,12 @@
 // ʵ�� DataManager �࣬������غ͹�����Ϸ����
+// 2026.10.17 by BillyDu: 先加载 data/atlases.json 列出的图集，动画帧能命中图集时直接用图集子帧
 #include "DataManager.h"
 #include "cocos2d.h"
 #include "json/document.h" // RapidJSON
 #include "../Utils/GameException.h"
+#include "../Utils/AnimationHelper.h"
+#include "../Sim/PlantBehaviorRegistry.h"
+#include "../Sim/TraceWriter.h"
 
 using namespace rapidjson;
 
@@ -14,8 +18,10 @@ DataManager& DataManager::getInstance() {
 void DataManager::loadData() {
     // 集中加载所有数据文件
     try {
+        loadAtlases("data/atlases.json"); // 可选，由 pack_atlases 生成
         loadPlants("data/plants.json");
         loadZombies("data/zombies.json"); // 待扩展
+        _simData = SimDataSnapshot::create(_plantDataMap, _zombieDataMap);
         cocos2d::log("[Info] All data loaded successfully.");
     }
     catch (const std::exception& e) {
@@ -26,6 +32,7 @@ void DataManager::loadData() {
 }
 
 void DataManager::loadPlants(const std::string& filename) {
+    PVZ_TRACE_SCOPE("DataManager::loadPlants", "data", filename.c_str());
     std::string fullPath = cocos2d::FileUtils::getInstance()->fullPathForFilename(filename);
 
     if (fullPath.empty()) {
@@ -58,6 +65,7 @@ void DataManager::loadPlants(const std::string& filename) {
 
         data.name = val["name"].GetString();
         data.type = val.HasMember("type") ? val["type"].GetString() : "unknown";
+        data.category = PlantBehaviorRegistry::categoryFromName(data.type);
         data.hp = val["hp"].GetInt();
         data.cost = val["cost"].GetInt();
         data.cooldown = val["cooldown"].GetFloat();
@@ -116,6 +124,8 @@ void DataManager::loadPlants(const std::string& filename) {
                     animConfig.onComplete = animVal["onComplete"].GetString();
                 }
                 
+                resolveAtlasFrames(animConfig);
+                animConfig.cacheKey = AnimationHelper::makeCacheKey(animConfig);
                 data.animations[animName] = animConfig;
             }
         }
@@ -130,6 +140,28 @@ void DataManager::loadPlants(const std::string& filename) {
             data.cardImage = val["cardImage"].GetString();
         }
 
+        // 行为及参数：字符串在这里一次性转成枚举，模拟中不再比较名字
+        // 规则（缺省值、哪些类型必须写 behavior、未知名字报错）统一在 PlantBehaviorRegistry::parse
+        bool hasBehavior = val.HasMember("behavior") && val["behavior"].IsObject();
+        PlantBehaviorFields fields;
+        if (hasBehavior) {
+            const auto& behaviorVal = val["behavior"];
+            if (behaviorVal.HasMember("kind")) fields.kind = behaviorVal["kind"].GetString();
+            if (behaviorVal.HasMember("projectile")) fields.projectile = behaviorVal["projectile"].GetString();
+            if (behaviorVal.HasMember("aoe")) fields.aoe = behaviorVal["aoe"].GetString();
+            PlantBehavior& p = fields.params;
+            if (behaviorVal.HasMember("volley")) p.volley = behaviorVal["volley"].GetInt();
+            if (behaviorVal.HasMember("volleyDelay")) p.volleyDelay = behaviorVal["volleyDelay"].GetFloat();
+            if (behaviorVal.HasMember("fuse")) p.fuse = behaviorVal["fuse"].GetFloat();
+            if (behaviorVal.HasMember("eatCooldown")) p.eatCooldown = behaviorVal["eatCooldown"].GetFloat();
+            if (behaviorVal.HasMember("crushDamage")) p.crushDamage = behaviorVal["crushDamage"].GetInt();
+        }
+        std::string reason;
+        if (!PlantBehaviorRegistry::parse(data.category, hasBehavior ? &fields : nullptr, data.behavior, reason)) {
+            throw GameException("[Err] Plant " + std::to_string(id) + " (" + data.name + "): " + reason);
+        }
+        CCLOG("[Info] Plant %d (%s) behavior: %s", id, data.name.c_str(), PlantBehaviorRegistry::kindName(data.behavior.kind));
+
         // ���뵽 Map ��
         _plantDataMap[id] = data;
     }
@@ -154,6 +186,7 @@ const ZombieData& DataManager::getZombieData(int id) const {
 
 // [待实现] 实现 loadZombies (逻辑类似 loadPlants)
 void DataManager::loadZombies(const std::string& filename) {
+    PVZ_TRACE_SCOPE("DataManager::loadZombies", "data", filename.c_str());
     std::string fullPath = cocos2d::FileUtils::getInstance()->fullPathForFilename(filename);
     if (fullPath.empty()) throw GameException("Config file not found: " + filename);
 
@@ -176,6 +209,7 @@ void DataManager::loadZombies(const std::string& filename) {
         data.damage = val.HasMember("damage") ? val["damage"].GetInt() : 10;
         data.speed = val.HasMember("speed") ? val["speed"].GetFloat() : 10.0f;
         data.attackInterval = val.HasMember("attackInterval") ? val["attackInterval"].GetFloat() : 1.0f;
+        if (val.HasMember("hitWidth")) data.hitWidth = val["hitWidth"].GetFloat();
         data.texturePath = val.HasMember("texture") ? val["texture"].GetString() : "";
 
         // ���ض�������
@@ -206,6 +240,8 @@ void DataManager::loadZombies(const std::string& filename) {
                     animConfig.onComplete = animVal["onComplete"].GetString();
                 }
                 
+                resolveAtlasFrames(animConfig);
+                animConfig.cacheKey = AnimationHelper::makeCacheKey(animConfig);
                 data.animations[animName] = animConfig;
             }
         }
@@ -218,4 +254,44 @@ void DataManager::loadZombies(const std::string& filename) {
         _zombieDataMap[id] = data;
         CCLOG("[Info] Loaded Zombie ID: %d (%s) with %zu animations", id, data.name.c_str(), data.animations.size());
     }
-}
\ No newline at end of file
+}
+
+void DataManager::loadAtlases(const std::string& filename) {
+    PVZ_TRACE_SCOPE("DataManager::loadAtlases", "data", filename.c_str());
+    auto fileUtils = cocos2d::FileUtils::getInstance();
+    if (!fileUtils->isFileExist(filename)) {
+        // 没有打包图集：动画逐帧从散图加载
+        CCLOG("[Info] %s not found, using loose animation frames", filename.c_str());
+        return;
+    }
+
+    Document doc;
+    doc.Parse(fileUtils->getStringFromFile(filename).c_str());
+    if (doc.HasParseError() || !doc.IsObject() || !doc.HasMember("atlases") || !doc["atlases"].IsArray()) {
+        throw GameException("[Err] Invalid atlas list in " + filename);
+    }
+
+    auto frameCache = cocos2d::SpriteFrameCache::getInstance();
+    for (const auto& entry : doc["atlases"].GetArray()) {
+        std::string plist = entry.GetString();
+        if (!fileUtils->isFileExist(plist)) {
+            // 图集清单与资源不同步时退回散图，不影响游戏
+            CCLOG("[Warn] Atlas %s listed in %s is missing", plist.c_str(), filename.c_str());
+            continue;
+        }
+        frameCache->addSpriteFramesWithFile(plist);
+        ++_atlasCount;
+        CCLOG("[Info] Loaded atlas: %s", plist.c_str());
+    }
+}
+
+void DataManager::resolveAtlasFrames(AnimationConfig& config) const {
+    // 所有帧都在已加载的图集里才算命中，缺一帧就整段走散图，避免同一动画混用两种纹理
+    config.inAtlas = _atlasCount > 0 && config.frameCount > 0;
+    auto frameCache = cocos2d::SpriteFrameCache::getInstance();
+    char framePath[256];
+    for (int i = 1; i <= config.frameCount && config.inAtlas; ++i) {
+        snprintf(framePath, sizeof(framePath), config.frameFormat.c_str(), i);
+        config.inAtlas = frameCache->getSpriteFrameByName(framePath) != nullptr;
+    }
+}
@@ -1,4 +1,6 @@
 // ��ͷ�ļ���������Ϸ���ݹ����� DataManager��������غ��ṩ��Ϸ�и���ʵ������ݡ�
+// 2026.10.17 by BillyDu: optional texture atlases (data/atlases.json)
+// 2026.10.17 by BillyDu: definitions handed to simulations as one immutable shared snapshot
 // 2025.11.27 by BillyDu
 #ifndef __DATA_MANAGER_H__
 #define __DATA_MANAGER_H__
@@ -6,6 +8,7 @@
 #include <unordered_map>
 #include <string>
 #include "../Entities/GameDataStructures.h"
+#include "../Sim/SimDataSnapshot.h"
 
 class DataManager {
 public:
@@ -25,6 +28,10 @@ public:
     // ��ȡ��ʬ������
 	const ZombieData& getZombieData(int id) const;
 
+    // Read-only copy of both tables for Simulation (SimSetup::data), built by loadData;
+    // every game shares it, so it stays valid and unchanged while the game runs
+    SimDataPtr getSimData() const { return _simData; }
+
 private:
     DataManager() = default; // ˽�й���
 
@@ -39,6 +46,16 @@ private:
 
     // ��ʬ���ݻ���
     std::unordered_map<int, ZombieData> _zombieDataMap;
+
+    // Load the atlases listed by the packer (optional file; missing = loose frames)
+    void loadAtlases(const std::string& filename);
+
+    // Mark an animation as atlas-backed when every frame is in SpriteFrameCache
+    void resolveAtlasFrames(AnimationConfig& config) const;
+
+    int _atlasCount = 0;
+
+    SimDataPtr _simData;
 };
 
 #endif // __DATA_MANAGER_H__
\ No newline at end of file
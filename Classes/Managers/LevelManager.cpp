@@ -4,6 +4,7 @@
 #include "cocos2d.h"
 #include "json/document.h"
 #include "../Utils/GameException.h"
+#include "../Sim/TraceWriter.h"
 
 using namespace rapidjson;
 
@@ -12,10 +13,21 @@ LevelManager& LevelManager::getInstance() {
     return instance;
 }
 
+std::string LevelManager::getLevelFile(int mapId) {
+    if (mapId == 2) {
+        return "data/level_map2.json";
+    }
+    if (mapId == 4) {
+        return "data/level_map4.json";
+    }
+    return "data/level_test.json";
+}
+
 void LevelManager::loadLevel(const std::string& filename) {
+    PVZ_TRACE_SCOPE("LevelManager::loadLevel", "data", filename.c_str());
     _waves.clear();
-    _gameTime = 0.0f;
-    _isLevelFinished = false;
+    _poolSizes = LevelPoolSizes();
+    _terrain = LawnTerrain();
 
     std::string fullPath = cocos2d::FileUtils::getInstance()->fullPathForFilename(filename);
     if (fullPath.empty()) {
@@ -49,6 +61,27 @@ void LevelManager::loadLevel(const std::string& filename) {
         }
     }
 
+    // 对象池大小（可选）
+    if (doc.HasMember("pools") && doc["pools"].IsObject()) {
+        const Value& p = doc["pools"];
+        if (p.HasMember("bullets")) _poolSizes.bullets = p["bullets"].GetInt();
+        if (p.HasMember("zombies")) _poolSizes.zombies = p["zombies"].GetInt();
+        if (p.HasMember("suns")) _poolSizes.suns = p["suns"].GetInt();
+        if (p.HasMember("effects")) _poolSizes.effects = p["effects"].GetInt();
+    }
+
+    // 地形（可选）：水池行
+    if (doc.HasMember("terrain") && doc["terrain"].IsObject()) {
+        const Value& t = doc["terrain"];
+        if (t.HasMember("waterRows")) {
+            if (!t["waterRows"].IsArray()) throw GameException("[Err] Level terrain.waterRows must be an array");
+            const Value& rows = t["waterRows"];
+            for (SizeType i = 0; i < rows.Size(); i++) {
+                _terrain.setRow(rows[i].GetInt(), TERRAIN_WATER);
+            }
+        }
+    }
+
     // 获取 waves 数据
     if (doc.HasMember("waves") && doc["waves"].IsArray()) {
         const Value& waves = doc["waves"];
@@ -63,39 +96,3 @@ void LevelManager::loadLevel(const std::string& filename) {
         }
     }
 }
-
-void LevelManager::update(float dt, const std::function<void(int, int)>& onSpawnCallback) {
-    if (_isLevelFinished) return;
-
-    _gameTime += dt;
-    bool allSpawned = true;
-
-    // 遍历所有刷新事件
-    for (auto& evt : _waves) {
-        if (!evt.spawned) {
-            allSpawned = false;
-            if (_gameTime >= evt.time) {
-                // 时间到了，触发刷新
-                if (onSpawnCallback) {
-                    onSpawnCallback(evt.zombieId, evt.row);
-                }
-                evt.spawned = true;
-            }
-        }
-    }
-
-    if (allSpawned) {
-        _isLevelFinished = true;
-        cocos2d::log("[Info] Level Waves Finished!");
-    }
-}
-
-bool LevelManager::isAllWavesCompleted() const {
-    // 检查是否所有刷新事件都已完成
-    for (const auto& wave : _waves) {
-        if (!wave.spawned) {
-            return false; // ����δ��ɵĲ���
-        }
-    }
-    return true; // ���в��ζ������
-}
\ No newline at end of file
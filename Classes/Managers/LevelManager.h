@@ -5,15 +5,8 @@
 
 #include <vector>
 #include <string>
-#include <functional> // C++11 std::function
-
-// 定义一个简单的结构存储刷新信息
-struct SpawnEvent {
-    float time;
-    int zombieId;
-    int row;
-    bool spawned = false; // 是否已刷新
-};
+#include "../Entities/GameDataStructures.h" // SpawnEvent
+#include "../Sim/SimTypes.h" // LawnTerrain
 
 // 定义一个结构存储关卡UI信息
 struct LevelAssets {
@@ -22,6 +15,14 @@ struct LevelAssets {
     std::string seedSlotPath;
 };
 
+// 关卡对象池大小（JSON 中的 "pools"，缺省时使用这里的默认值）
+struct LevelPoolSizes {
+    int bullets = 32;
+    int zombies = 16;
+    int suns = 8;
+    int effects = 2;
+};
+
 class LevelManager {
 public:
     static LevelManager& getInstance();
@@ -29,30 +30,35 @@ public:
     // ���عؿ�����
     void loadLevel(const std::string& filename);
 
-    // 每帧更新，检查是否需要刷新
-    // onSpawnCallback: 需要刷新时调用的回调函数 (参数: id, row)
-    void update(float dt, const std::function<void(int, int)>& onSpawnCallback);
+    // 地图（章节）ID 对应的关卡文件：Map2/Map4 有独立配置，其余使用 level_test.json
+    static std::string getLevelFile(int mapId);
+
+    // 关卡刷新时间轴（按 JSON 顺序），由 Simulation 逐帧推进
+    const std::vector<SpawnEvent>& getWaves() const { return _waves; }
+
+    // 地形（JSON 中的 "terrain"，如水池行），缺省时没有水
+    const LawnTerrain& getTerrain() const { return _terrain; }
 
     // 获取当前关卡资源
     const LevelAssets& getAssets() const { return _assets; }
 
+    // 获取当前关卡的对象池预分配数量
+    const LevelPoolSizes& getPoolSizes() const { return _poolSizes; }
+
     // ���ñ���·�������ڵ�ͼѡ��
     void setBackgroundPath(const std::string& bgPath) { 
         _assets.bgPath = bgPath; 
         _isBgPathManuallySet = true; // ���Ϊ�ֶ�����
     }
 
-    // ����Ƿ����в��ζ������
-    bool isAllWavesCompleted() const;
-
 private:
     LevelManager() = default;
 
     std::vector<SpawnEvent> _waves;
-    float _gameTime = 0.0f;
-    bool _isLevelFinished = false;
     bool _isBgPathManuallySet = false; // ��Ǳ���·���Ƿ��ֶ�����
 	LevelAssets _assets;
+    LevelPoolSizes _poolSizes;
+    LawnTerrain _terrain;
 };
 
 #endif // __LEVEL_MANAGER_H__
\ No newline at end of file
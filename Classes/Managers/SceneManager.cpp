@@ -4,6 +4,7 @@
 #include "../Scenes/StartScene.h"
 #include "../Scenes/MapSelectScene.h"
 #include "../Scenes/PlantSelectScene.h"
+#include "../Scenes/LoadingScene.h"
 #include "../Scenes/GameScene.h"
 #include "../Scenes/VictoryScene.h"
 #include "../Scenes/GameOverScene.h"
@@ -43,6 +44,12 @@ void SceneManager::gotoPlantSelectScene() {
     AudioManager::getInstance().playBackgroundMusic(AudioPath::MAIN_MENU_BGM);
 }
 
+void SceneManager::gotoLoadingScene() {
+    _currentState = GameState::MENU;
+    auto scene = LoadingScene::createScene();
+    replaceSceneWithTransition(scene);
+}
+
 void SceneManager::gotoGameScene() {
     _currentState = GameState::PLAYING;
     auto scene = GameScene::createScene();
@@ -1,5 +1,6 @@
 // 场景管理器 - 统一管理场景的切换
 // 2025.12.15 by BillyDu
+// 2026.10.17 by BillyDu: 植物选择后先进入 LoadingScene
 #ifndef __SCENE_MANAGER_H__
 #define __SCENE_MANAGER_H__
 
@@ -14,6 +15,7 @@ public:
     void gotoStartScene();
     void gotoMapSelectScene();
     void gotoPlantSelectScene();
+    void gotoLoadingScene();   // 预加载本关资源，完成后自动进入 GameScene
     void gotoGameScene();
     void gotoVictoryScene();
     void gotoGameOverScene();
@@ -3,20 +3,35 @@
 //edited on 2025.12.21 by Zhao
 // ���£���Ӱ����ֵ������ȴʱ�书�ܣ�����5�룬���10�룩����ֲ�������ȴ
 // by Zhao.12.23
+// 2026.10.17 by BillyDu: gameplay moved into Simulation (Classes/Sim), GameScene only mirrors it into sprites
 #ifndef __GAME_SCENE_H__
 #define __GAME_SCENE_H__
 
 #include <vector>
 #include <utility>
-#include <set>
+#include <memory>
 
 #include "cocos2d.h"
+#include "ui/CocosGUI.h"
 #include "../Entities/Zombie.h"
 #include "../Entities/Plant.h"
 #include "../Entities/Bullet.h"
+#include "../Entities/Sun.h"
+#include "../Entities/Effect.h"
+#include "../Utils/EntityPool.h"
+#include "../Sim/Simulation.h"
 #include "../UI/SeedCard.h"
+#include "../UI/ProfilerOverlay.h"
 #include "../Consts.h"
 
+// 快进档位：每个渲染帧推进的固定步数倍率；MAX 在帧预算内尽量多跑
+enum class GameSpeed {
+    X1,
+    X2,
+    X4,
+    MAX
+};
+
 class GameScene : public cocos2d::Scene {
 public:
     static cocos2d::Scene* createScene();
@@ -38,54 +53,62 @@ public:
     // 调试功能：在屏幕上绘制网格
     void drawDebugGrid();
 
+    // --- 游戏速度 ---
+    void setGameSpeed(GameSpeed speed);
+    GameSpeed getGameSpeed() const { return _gameSpeed; }
+
     CREATE_FUNC(GameScene);
 
 private:
-	cocos2d::Vector<Plant*> _plants;   // ���ϵ�ֲ���б�
-    cocos2d::Vector<Zombie*> _zombies; // ���ϵĽ�ʬ�б�
-   
-	// ���ɽ�ʬ
-	void spawnZombie(int id, int row);
+    // 游戏逻辑（刷怪、战斗、阳光、冷却）全部在 Simulation 中
+    std::unique_ptr<Simulation> _sim;
+    float _tickAccumulator = 0.0f;  // 尚未模拟的帧时间（秒），固定步长推进
+    GameSpeed _gameSpeed = GameSpeed::X1;
+    cocos2d::ui::Button* _speedButton = nullptr;
+
+    // 按当前速度推进模拟，返回渲染插值系数
+    float advanceSimulation(float dt);
+
+    // 每阶段耗时统计（F3 打开浮层时才计时）
+    FrameProfiler _profiler;
+    ProfilerOverlay* _profilerOverlay = nullptr;
+
+    // 模拟实体 ID -> 对应精灵
+    cocos2d::Map<SimId, Zombie*> _zombieSprites;
+    cocos2d::Map<SimId, Plant*> _plantSprites;
+    cocos2d::Map<SimId, Bullet*> _bulletSprites;
+    cocos2d::Map<SimId, Sun*> _sunSprites;
+
+    // 对象池：大小由关卡配置决定，战斗中复用节点而不是反复创建
+    EntityPool<Zombie> _zombiePool;
+    EntityPool<Bullet> _bulletPool;
+    EntityPool<Sun> _sunPool;
+    EntityPool<Effect> _effectPool;
+
+    // 把 Simulation 的事件绑定到精灵、动画和音效
+    void bindSimCallbacks();
+
     // ��ֲֲ��
     void tryPlantAt(int row, int col);
     void selectPlant(int plantId);
     // ��ȡֲ��
     void tryDigAt(int row, int col);
 
-    Plant* _plantMap[6][GRID_COLS]; // 逻辑网格上的植物指针（最大6行，Map2/Map4使用6行，Map1/Map3使用5行）
-
-    // 动态网格行数（根据地图类型：Map1/Map3=5行，Map2/Map4=6行）
-    int _actualGridRows = GRID_ROWS;
+    // 网格几何（根据地图类型：Map1/Map3=5行，Map2/Map4=6行）
+    LawnGeometry _geometry;
 
     // ��Ϸ״̬
-    int _currentSun = 500; // 初始阳光值
     int _selectedPlantId = -1; // 当前选中的植物ID，-1表示未选中
     GameState _gameState = GameState::PLAYING; // ��Ϸ״̬
 
-    // 冷却时间计算相关
-    int _minCost = 0;  // 最小阳光值
-    int _maxCost = 0;  // 最大阳光值
-    
-    // 根据阳光值计算冷却时间（最少5秒，最多10秒）
-    float calculateCooldownByCost(int cost) const;
-
     // UI Label：用于显示阳光
 	cocos2d::Label* _sunLabel = nullptr;
 
-    // 子弹管理
-    cocos2d::Vector<Bullet*> _bullets;
-
-    // 创建子弹的通用逻辑
-    void createBullet(cocos2d::Vec2 startPos, int damage, BulletType type = BulletType::NORMAL, const std::string& texturePath = "");
-
-    // 创建蘑菇子弹（带动画）
-    void createMushroomBullet(cocos2d::Vec2 startPos, int damage);
+    // 为 Simulation 发射的子弹创建精灵
+    void createBullet(const SimBullet& bullet);
 
-    // 创建爆炸动画（boom1用于CherryBomb，boom2用于PotatoMine）
-    void createExplosionAnimation(cocos2d::Vec2 pos, const std::string& boomType, int damage, int row, int col);
-
-    // 战斗逻辑更新（碰撞检测和AI检查）
-    void updateCombatLogic();
+    // 创建爆炸动画（boom1用于CherryBomb，boom2用于PotatoMine），伤害在 Simulation 中结算
+    void createExplosionAnimation(cocos2d::Vec2 pos, const std::string& boomType);
 
     // [UI] 种子卡片
     cocos2d::Vector<SeedCard*> _seedCards;
@@ -106,13 +129,13 @@ private:
     // [Helper] ��������λ��
     void updateGhostPosition(cocos2d::Vec2 mousePos);
     
-    // [Game Flow] 胜利条件检查
-    void checkVictoryCondition();
-    void checkGameOverCondition();
+    // [Game Flow] 结束游戏（胜负由 Simulation 判断）
     void endGame(bool isVictory);
     
     // [UI] 暂停按钮 / 暂停菜单
     void createPauseButton();
+    // [UI] 速度按钮：1x -> 2x -> 4x -> max 循环
+    void createSpeedButton();
     void onPauseButtonClicked(cocos2d::Ref* sender);
     void pauseGame();
     void resumeGame();
@@ -123,18 +146,9 @@ private:
     void createShovelUI(cocos2d::Node* uiLayer, float x, float y);
     void resetShovel();
 
-    // 动态网格参数（根据背景大小调整）
-    float _actualGridStartX = GRID_START_X;
-    float _actualGridStartY = GRID_START_Y;
-    float _actualCellWidth = CELL_WIDTH;
-    float _actualCellHeight = CELL_HEIGHT;
-    
     // 计算网格实际参数的方法
     void calculateGridParameters(cocos2d::Sprite* background);
     
-    // Boss2 ice tracking (grid positions where ice has been placed)
-    std::set<std::pair<int, int>> _icePositions;  // (row, col) pairs
-
     // ��ͣ�˵��㣨ESC ����ͣ��ť������
     cocos2d::LayerColor* _pauseLayer = nullptr;
 };
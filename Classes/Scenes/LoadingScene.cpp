@@ -0,0 +1,160 @@
+// 关卡加载场景实现
+// 2026.10.17 by BillyDu
+#include "LoadingScene.h"
+#include "../Managers/DataManager.h"
+#include "../Managers/LevelManager.h"
+#include "../Managers/SceneManager.h"
+#include "../Utils/AnimationHelper.h"
+#include "../Sim/TraceWriter.h"
+
+USING_NS_CC;
+
+Scene* LoadingScene::createScene() {
+    return LoadingScene::create();
+}
+
+bool LoadingScene::init() {
+    if (!Scene::init()) {
+        return false;
+    }
+
+    _visibleSize = Director::getInstance()->getVisibleSize();
+    _origin = Director::getInstance()->getVisibleOrigin();
+
+    createUI();
+    buildManifest();
+
+    return true;
+}
+
+void LoadingScene::onEnter() {
+    Scene::onEnter();
+    startLoading();
+}
+
+void LoadingScene::onExit() {
+    if (!_finished) {
+        // 中途离开（例如退出游戏）：取消未完成的回调，避免回调到已释放的场景
+        auto textureCache = Director::getInstance()->getTextureCache();
+        for (const auto& path : _manifest.getTextures()) {
+            textureCache->unbindImageAsync(path);
+        }
+    }
+    Scene::onExit();
+}
+
+void LoadingScene::createUI() {
+    auto bg = LayerColor::create(Color4B(0, 0, 0, 255));
+    this->addChild(bg, -1);
+
+    float centerX = _visibleSize.width / 2 + _origin.x;
+    float centerY = _visibleSize.height / 2 + _origin.y;
+
+    auto title = Label::createWithTTF("Loading...", "fonts/Marker Felt.ttf", 48);
+    title->setPosition(centerX, centerY + 60);
+    title->setColor(Color3B::YELLOW);
+    this->addChild(title, 1);
+
+    // 进度条：底框 + 按进度拉伸的填充条
+    _progressWidth = _visibleSize.width * 0.5f;
+    float barHeight = 24.0f;
+    auto barBg = LayerColor::create(Color4B(60, 60, 60, 255), _progressWidth, barHeight);
+    barBg->setPosition(centerX - _progressWidth / 2, centerY - barHeight / 2);
+    this->addChild(barBg, 1);
+
+    _progressFill = LayerColor::create(Color4B(0, 180, 0, 255), 0.0f, barHeight);
+    _progressFill->setPosition(barBg->getPosition());
+    this->addChild(_progressFill, 2);
+
+    _progressLabel = Label::createWithTTF("0%", "fonts/Marker Felt.ttf", 24);
+    _progressLabel->setPosition(centerX, centerY - 40);
+    this->addChild(_progressLabel, 1);
+}
+
+void LoadingScene::buildManifest() {
+    int mapId = SceneManager::getInstance().getCurrentMapId();
+
+    std::vector<int> plantIds = SceneManager::getInstance().getSelectedPlants();
+    if (plantIds.empty()) {
+        plantIds = { 1001, 1002, 1008 }; // 与 GameScene 的默认卡组一致
+    }
+
+    try {
+        DataManager::getInstance().loadData();
+        LevelManager::getInstance().loadLevel(LevelManager::getLevelFile(mapId));
+    }
+    catch (const std::exception& e) {
+        // 数据有问题时不预加载，交给 GameScene::init 报错
+        CCLOG("[Err] LoadingScene: %s", e.what());
+        return;
+    }
+
+    _manifest = AssetManifest::buildForLevel(plantIds, LevelManager::getInstance().getWaves(),
+                                             LevelManager::getInstance().getTerrain());
+
+    const auto& assets = LevelManager::getInstance().getAssets();
+    _manifest.addTexture(assets.bgPath);
+    _manifest.addTexture(assets.sunBarPath);
+    _manifest.addTexture(assets.seedSlotPath);
+}
+
+void LoadingScene::startLoading() {
+    const auto& textures = _manifest.getTextures();
+    if (textures.empty()) {
+        onLoadingFinished();
+        return;
+    }
+
+    auto textureCache = Director::getInstance()->getTextureCache();
+    for (const auto& path : textures) {
+        // 已在缓存中的图片会在下一帧直接回调
+        textureCache->addImageAsync(path, CC_CALLBACK_1(LoadingScene::onTextureLoaded, this));
+    }
+}
+
+void LoadingScene::onTextureLoaded(Texture2D* texture) {
+    if (!texture) {
+        // 缺失的图片也计入进度，GameScene 中会回退到同步加载 / 占位
+        CCLOG("[Warn] LoadingScene: a texture failed to load");
+    }
+    else {
+        PVZ_TRACE_INSTANT("texture ready (async)", "assets", texture->getPath().c_str());
+    }
+    ++_loadedCount;
+    updateProgress();
+
+    if (_loadedCount >= _manifest.getTextures().size()) {
+        onLoadingFinished();
+    }
+}
+
+void LoadingScene::updateProgress() {
+    size_t total = _manifest.getTextures().size();
+    float progress = total > 0 ? (float)_loadedCount / total : 1.0f;
+    _progressFill->setContentSize(Size(_progressWidth * progress, _progressFill->getContentSize().height));
+
+    char text[32];
+    snprintf(text, sizeof(text), "%d%%", (int)(progress * 100));
+    _progressLabel->setString(text);
+}
+
+void LoadingScene::onLoadingFinished() {
+    if (_finished) {
+        return;
+    }
+    _finished = true;
+    updateProgress();
+
+    // 纹理已在缓存中，这里只创建 SpriteFrame / Animation（存入 AnimationCache，开局直接命中）
+    PVZ_TRACE_SCOPE("LoadingScene::buildAnimations", "assets");
+    for (const auto& config : _manifest.getAnimations()) {
+        AnimationHelper::createAnimationFromConfig(config);
+    }
+    CCLOG("[Info] LoadingScene: %zu textures, %zu animations ready",
+          _manifest.getTextures().size(), _manifest.getAnimations().size());
+
+    // 留一帧让进度条显示 100%
+    this->scheduleOnce([](float) {
+        SceneManager::getInstance().gotoGameScene();
+    }, 0.1f, "enter_game");
+}
@@ -0,0 +1,41 @@
+// 关卡加载场景：植物选择之后、GameScene 之前，异步预加载本关用到的纹理并显示进度条
+// 2026.10.17 by BillyDu
+#ifndef __LOADING_SCENE_H__
+#define __LOADING_SCENE_H__
+
+#include "cocos2d.h"
+#include "../Utils/AssetManifest.h"
+
+class LoadingScene : public cocos2d::Scene {
+public:
+    static cocos2d::Scene* createScene();
+    virtual bool init() override;
+    virtual void onEnter() override;
+    virtual void onExit() override;
+
+    CREATE_FUNC(LoadingScene);
+
+private:
+    void createUI();
+    void buildManifest();
+
+    // 所有图片通过 TextureCache::addImageAsync 在工作线程解码，回调在主线程
+    void startLoading();
+    void onTextureLoaded(cocos2d::Texture2D* texture);
+    void updateProgress();
+    // 纹理全部就绪：构建动画帧并进入 GameScene
+    void onLoadingFinished();
+
+    AssetManifest _manifest;
+    size_t _loadedCount = 0;
+    bool _finished = false;
+
+    cocos2d::LayerColor* _progressFill = nullptr;
+    cocos2d::Label* _progressLabel = nullptr;
+    float _progressWidth = 0.0f;
+
+    cocos2d::Size _visibleSize;
+    cocos2d::Vec2 _origin;
+};
+
+#endif // __LOADING_SCENE_H__
@@ -359,8 +359,8 @@ void PlantSelectScene::onConfirmButtonClicked(cocos2d::Ref* sender) {
     // 播放音效
     AudioManager::getInstance().playEffect(AudioPath::PLANT_SOUND);
     
-    // 进入游戏场景
-    SceneManager::getInstance().gotoGameScene();
+    // 先预加载本关资源，再进入游戏场景
+    SceneManager::getInstance().gotoLoadingScene();
 }
 
 void PlantSelectScene::onBackButtonClicked(cocos2d::Ref* sender) {
@@ -133,17 +133,8 @@ void VictoryScene::onNextLevelButtonClicked(cocos2d::Ref* sender) {
     LevelManager::getInstance().setBackgroundPath(bgPath);
     
     // 加载对应地图的关卡配置
-    std::string levelFile;
-    if (nextMapId == 2) {
-        levelFile = "data/level_map2.json";
-    } else if (nextMapId == 4) {
-        levelFile = "data/level_map4.json";
-    } else {
-        levelFile = "data/level_test.json";
-    }
-    
     try {
-        LevelManager::getInstance().loadLevel(levelFile);
+        LevelManager::getInstance().loadLevel(LevelManager::getLevelFile(nextMapId));
     } catch (...) {
         CCLOG("[Warn] Failed to load level config for map %d", nextMapId);
     }
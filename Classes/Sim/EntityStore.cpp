@@ -0,0 +1,177 @@
+// Struct-of-arrays entity storage
+// 2026.10.17 by BillyDu
+#include "EntityStore.h"
+
+namespace {
+    // Swap-and-pop one component
+    template <typename T>
+    void swapPop(std::vector<T>& column, size_t index) {
+        if (index + 1 != column.size()) column[index] = column.back();
+        column.pop_back();
+    }
+}
+
+size_t SimZombieStore::add(SimId zombieId) {
+    size_t i = id.size();
+    id.push_back(zombieId);
+    handle.push_back(_handles.create((uint32_t)i));
+    typeId.push_back(0);
+    data.push_back(nullptr);
+    row.push_back(0);
+    x.push_back(0.0f);
+    y.push_back(0.0f);
+    prevX.push_back(0.0f);
+    prevY.push_back(0.0f);
+    hp.push_back(0);
+    maxHp.push_back(0);
+    state.push_back(ZombieState::WALK);
+    walkSpeed.push_back(0.0f);
+    nextBiteTick.push_back(0);
+    speedMultiplier.push_back(1.0f);
+    phase.push_back(1);
+    walk2.push_back(0);
+    walk2Timer.push_back(TimerHandle());
+    isBoss1.push_back(0);
+    isCrushing.push_back(0);
+    return i;
+}
+
+void SimZombieStore::remove(size_t index) {
+    _handles.destroy(handle[index]);
+    if (index + 1 != id.size()) _handles.relocate(handle.back(), (uint32_t)index);
+
+    swapPop(id, index);
+    swapPop(handle, index);
+    swapPop(typeId, index);
+    swapPop(data, index);
+    swapPop(row, index);
+    swapPop(x, index);
+    swapPop(y, index);
+    swapPop(prevX, index);
+    swapPop(prevY, index);
+    swapPop(hp, index);
+    swapPop(maxHp, index);
+    swapPop(state, index);
+    swapPop(walkSpeed, index);
+    swapPop(nextBiteTick, index);
+    swapPop(speedMultiplier, index);
+    swapPop(phase, index);
+    swapPop(walk2, index);
+    swapPop(walk2Timer, index);
+    swapPop(isBoss1, index);
+    swapPop(isCrushing, index);
+}
+
+size_t SimZombieStore::indexOf(SimHandle zombie) const {
+    uint32_t index = _handles.lookup(zombie);
+    return index != HandleTable::NONE ? index : NONE;
+}
+
+SimZombie SimZombieStore::get(size_t i) const {
+    SimZombie z;
+    z.id = id[i];
+    z.typeId = typeId[i];
+    z.data = data[i];
+    z.row = row[i];
+    z.x = x[i];
+    z.y = y[i];
+    z.prevX = prevX[i];
+    z.prevY = prevY[i];
+    z.hp = hp[i];
+    z.maxHp = maxHp[i];
+    z.state = state[i];
+    z.speedMultiplier = speedMultiplier[i];
+    z.phase = phase[i];
+    z.walk2 = walk2[i] != 0;
+    z.isBoss1 = isBoss1[i] != 0;
+    z.isCrushing = isCrushing[i] != 0;
+    return z;
+}
+
+void SimZombieStore::clear() {
+    id.clear();
+    handle.clear();
+    typeId.clear();
+    data.clear();
+    row.clear();
+    x.clear();
+    y.clear();
+    prevX.clear();
+    prevY.clear();
+    hp.clear();
+    maxHp.clear();
+    state.clear();
+    walkSpeed.clear();
+    nextBiteTick.clear();
+    speedMultiplier.clear();
+    phase.clear();
+    walk2.clear();
+    walk2Timer.clear();
+    isBoss1.clear();
+    isCrushing.clear();
+    _handles.clear();
+}
+
+size_t SimBulletStore::add(SimId bulletId) {
+    size_t i = id.size();
+    id.push_back(bulletId);
+    kind.push_back(ProjectileKind::PEA);
+    row.push_back(0);
+    x.push_back(0.0f);
+    y.push_back(0.0f);
+    prevX.push_back(0.0f);
+    prevY.push_back(0.0f);
+    damage.push_back(0);
+    speed.push_back(400.0f);
+    slowEffect.push_back(1.0f);
+    hitWidth.push_back(37.0f);
+    active.push_back(1);
+    return i;
+}
+
+void SimBulletStore::remove(size_t index) {
+    swapPop(id, index);
+    swapPop(kind, index);
+    swapPop(row, index);
+    swapPop(x, index);
+    swapPop(y, index);
+    swapPop(prevX, index);
+    swapPop(prevY, index);
+    swapPop(damage, index);
+    swapPop(speed, index);
+    swapPop(slowEffect, index);
+    swapPop(hitWidth, index);
+    swapPop(active, index);
+}
+
+void SimBulletStore::clear() {
+    id.clear();
+    kind.clear();
+    row.clear();
+    x.clear();
+    y.clear();
+    prevX.clear();
+    prevY.clear();
+    damage.clear();
+    speed.clear();
+    slowEffect.clear();
+    hitWidth.clear();
+    active.clear();
+}
+
+SimBullet SimBulletStore::get(size_t i) const {
+    SimBullet b;
+    b.id = id[i];
+    b.kind = kind[i];
+    b.row = row[i];
+    b.x = x[i];
+    b.y = y[i];
+    b.prevX = prevX[i];
+    b.prevY = prevY[i];
+    b.damage = damage[i];
+    b.speed = speed[i];
+    b.slowEffect = slowEffect[i];
+    b.hitWidth = hitWidth[i];
+    b.active = active[i] != 0;
+    return b;
+}
@@ -0,0 +1,89 @@
+// Struct-of-arrays storage for the sim's moving entities (zombies, bullets)
+// One dense array per component, index i is the same entity in every array, so per-tick loops
+// stream through exactly the components they touch. Removal moves the last entity into the hole
+// (swap-and-pop); the Simulation only removes in its cleanup phase, so indices hold for a whole tick
+// 2026.10.17 by BillyDu
+#ifndef __ENTITY_STORE_H__
+#define __ENTITY_STORE_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "SimHandle.h"
+#include "SimTypes.h"
+
+class SimZombieStore {
+public:
+    static const size_t NONE = (size_t)-1;
+
+    // --- Components ---
+    std::vector<SimId> id;                    // view key (sprites)
+    std::vector<SimHandle> handle;            // what timers / events keep instead of the index
+    std::vector<int> typeId;                  // final zombie ID (after the pool-row swap)
+    std::vector<const ZombieData*> data;      // level archetype (map multipliers applied)
+    std::vector<int> row;
+    std::vector<float> x;
+    std::vector<float> y;
+    std::vector<float> prevX;                 // position before the last tick (render interpolation)
+    std::vector<float> prevY;
+    std::vector<int> hp;
+    std::vector<int> maxHp;
+    std::vector<ZombieState> state;
+    std::vector<float> walkSpeed;             // px/s while moving, 0 while eating or dead (see setZombieState)
+    std::vector<SimTick> nextBiteTick;        // may bite again from this tick on
+    std::vector<float> speedMultiplier;       // 1.0 = normal, 0.5 = slowed by SnowPea
+    std::vector<int> phase;                   // Boss1: 1-2, Boss2: 1-4
+    std::vector<unsigned char> walk2;         // walk1 -> walk2 (swim) animation
+    std::vector<TimerHandle> walk2Timer;
+    std::vector<unsigned char> isBoss1;
+    std::vector<unsigned char> isCrushing;    // Boss2 (snow sled) never stops, crushes plants
+
+    size_t size() const { return id.size(); }
+    bool empty() const { return id.empty(); }
+    bool isDead(size_t i) const { return hp[i] <= 0; }
+
+    // Append a zombie with default components (and a fresh handle), returns its index
+    size_t add(SimId zombieId);
+    // Swap-and-pop: the last zombie moves to index; the removed zombie's handle goes stale
+    void remove(size_t index);
+    // Index of a zombie by handle in O(1), NONE when it is gone
+    size_t indexOf(SimHandle zombie) const;
+
+    // One zombie gathered into a plain record (callbacks, view)
+    SimZombie get(size_t i) const;
+
+    // Remove every zombie; the component arrays keep their capacity
+    void clear();
+
+private:
+    HandleTable _handles;
+};
+
+class SimBulletStore {
+public:
+    // --- Components ---
+    std::vector<SimId> id;
+    std::vector<ProjectileKind> kind;
+    std::vector<int> row;
+    std::vector<float> x;
+    std::vector<float> y;
+    std::vector<float> prevX;
+    std::vector<float> prevY;
+    std::vector<int> damage;
+    std::vector<float> speed;
+    std::vector<float> slowEffect;            // speed multiplier applied on hit (ICE_PEA only)
+    std::vector<float> hitWidth;              // collision box width (texture width)
+    std::vector<unsigned char> active;
+
+    size_t size() const { return id.size(); }
+    bool empty() const { return id.empty(); }
+
+    size_t add(SimId bulletId);
+    void remove(size_t index);
+    void clear();
+
+    SimBullet get(size_t i) const;
+};
+
+#endif // __ENTITY_STORE_H__
@@ -0,0 +1,69 @@
+// FrameProfiler implementation
+// 2026.10.17 by BillyDu
+#include "FrameProfiler.h"
+
+#include <algorithm>
+#include <vector>
+
+FrameProfiler::FrameProfiler() {
+    std::fill(&_current[0], &_current[0] + PHASE_COUNT, 0.0);
+    std::fill(&_history[0][0], &_history[0][0] + PHASE_COUNT * HISTORY_FRAMES, 0.0);
+}
+
+void FrameProfiler::setEnabled(bool enabled) {
+    if (_enabled == enabled) return;
+    _enabled = enabled;
+    // Old samples would mix with a different scene state; start over
+    _head = 0;
+    _frameCount = 0;
+    std::fill(&_current[0], &_current[0] + PHASE_COUNT, 0.0);
+}
+
+void FrameProfiler::beginFrame() {
+    std::fill(&_current[0], &_current[0] + PHASE_COUNT, 0.0);
+}
+
+void FrameProfiler::endFrame() {
+    if (!_enabled) return;
+    for (int i = 0; i < PHASE_COUNT; ++i) {
+        _history[i][_head] = _current[i];
+    }
+    _head = (_head + 1) % HISTORY_FRAMES;
+    if (_frameCount < HISTORY_FRAMES) ++_frameCount;
+}
+
+double FrameProfiler::getPercentile(ProfilePhase phase, double percentile) const {
+    if (_frameCount == 0) return 0.0;
+
+    // Slots [0, _frameCount) are valid whether or not the ring has wrapped
+    const double* samples = _history[static_cast<int>(phase)];
+    std::vector<double> sorted(samples, samples + _frameCount);
+    size_t rank = static_cast<size_t>(percentile / 100.0 * (_frameCount - 1) + 0.5);
+    rank = std::min(rank, sorted.size() - 1);
+    std::nth_element(sorted.begin(), sorted.begin() + rank, sorted.end());
+    return sorted[rank];
+}
+
+double FrameProfiler::getLast(ProfilePhase phase) const {
+    if (_frameCount == 0) return 0.0;
+    int last = (_head + HISTORY_FRAMES - 1) % HISTORY_FRAMES;
+    return _history[static_cast<int>(phase)][last];
+}
+
+const char* FrameProfiler::getPhaseName(ProfilePhase phase) {
+    switch (phase) {
+    case ProfilePhase::WAVES:        return "1 waves";
+    case ProfilePhase::ZOMBIES:      return "2 zombies";
+    case ProfilePhase::TIMERS:       return "3 timers";
+    case ProfilePhase::BULLETS:      return "4 bullets";
+    case ProfilePhase::COMBAT_HITS:  return "5A hits";
+    case ProfilePhase::COMBAT_BITES: return "5B bites";
+    case ProfilePhase::EVENTS:       return "6 events";
+    case ProfilePhase::CLEANUP:      return "7 cleanup";
+    case ProfilePhase::END_CHECK:    return "8 win/lose";
+    case ProfilePhase::SPRITE_SYNC:  return "sprites";
+    case ProfilePhase::UI:           return "ui";
+    case ProfilePhase::FRAME:        return "frame";
+    default:                         return "?";
+    }
+}
@@ -0,0 +1,106 @@
+// Per-phase frame profiler: scoped timers around the numbered phases of a frame,
+// rolling history for p50 / p99, read by the on-screen overlay (ProfilerOverlay)
+// Pure C++ so the Simulation phases can be timed without cocos2d
+// 2026.10.17 by BillyDu
+#ifndef __FRAME_PROFILER_H__
+#define __FRAME_PROFILER_H__
+
+#include <chrono>
+#include <cstdint>
+
+#include "TraceWriter.h"
+
+// Frame phases in execution order; the Simulation owns WAVES .. END_CHECK, GameScene the rest
+enum class ProfilePhase {
+    WAVES,          // 1. spawn timeline
+    ZOMBIES,        // 2. zombie movement / boss phases
+    TIMERS,         // 3. due timers: plant skills, delayed shots, fuses, sun expiry, sky sun
+    BULLETS,        // 4. bullet movement
+    COMBAT_HITS,    // 5A. bullets vs zombies
+    COMBAT_BITES,   // 5B. zombies eat / crush plants
+    EVENTS,         // 6. event batch handed to the view
+    CLEANUP,        // 7. dead entities removed
+    END_CHECK,      // 8. win / lose
+    SPRITE_SYNC,    // view: mirror sim entities into sprites, reclaim pools
+    UI,             // view: sun label and seed cards
+    FRAME,          // whole GameScene::update
+    COUNT
+};
+
+class FrameProfiler {
+public:
+    static const int PHASE_COUNT = static_cast<int>(ProfilePhase::COUNT);
+    static const int HISTORY_FRAMES = 240;   // ~4 s at 60 fps
+
+    FrameProfiler();
+
+    // Disabled: scopes skip the clock entirely (one branch per phase)
+    void setEnabled(bool enabled);
+    bool isEnabled() const { return _enabled; }
+
+    // Called by the frame owner around each update; endFrame commits the accumulated phase times
+    void beginFrame();
+    void endFrame();
+
+    // Accumulate microseconds into a phase of the current frame (a phase may run several times)
+    void addSample(ProfilePhase phase, double micros) { _current[static_cast<int>(phase)] += micros; }
+
+    // Percentile (0..100) of a phase over the rolling history, in microseconds
+    double getPercentile(ProfilePhase phase, double percentile) const;
+    double getLast(ProfilePhase phase) const;
+    int getFrameCount() const { return _frameCount; }
+
+    static const char* getPhaseName(ProfilePhase phase);
+
+private:
+    bool _enabled = false;
+    double _current[PHASE_COUNT];
+    double _history[PHASE_COUNT][HISTORY_FRAMES];
+    int _head = 0;        // next history slot
+    int _frameCount = 0;  // frames in history (<= HISTORY_FRAMES)
+};
+
+// RAII timer; a null or disabled profiler costs one branch (plus one when tracing is off)
+// While a trace is being written (TraceWriter) the phase is also recorded as a trace event
+class ProfileScope {
+public:
+    ProfileScope(FrameProfiler* profiler, ProfilePhase phase)
+        : _profiler(profiler && profiler->isEnabled() ? profiler : nullptr), _phase(phase),
+          _traced(TraceWriter::isActive()) {
+        if (_profiler || _traced) {
+            _start = std::chrono::steady_clock::now();
+        }
+    }
+
+    ~ProfileScope() {
+        if (!_profiler && !_traced) return;
+
+        auto end = std::chrono::steady_clock::now();
+        std::chrono::duration<double, std::micro> elapsed = end - _start;
+        if (_profiler) {
+            _profiler->addSample(_phase, elapsed.count());
+        }
+        if (_traced) {
+            uint64_t duration = (uint64_t)elapsed.count();
+            TraceWriter::getInstance().recordComplete(FrameProfiler::getPhaseName(_phase), "frame",
+                                                      TraceWriter::nowMicros() - duration, duration);
+        }
+    }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    FrameProfiler* _profiler;
+    ProfilePhase _phase;
+    bool _traced;
+    std::chrono::steady_clock::time_point _start;
+};
+
+#define PVZ_PROFILE_CONCAT_INNER(a, b) a##b
+#define PVZ_PROFILE_CONCAT(a, b) PVZ_PROFILE_CONCAT_INNER(a, b)
+// Time the rest of the enclosing block as the given phase
+#define PVZ_PROFILE_SCOPE(profiler, phase) \
+    ProfileScope PVZ_PROFILE_CONCAT(_profileScope, __LINE__)((profiler), (phase))
+
+#endif // __FRAME_PROFILER_H__
@@ -0,0 +1,169 @@
+// LaneIndex implementation
+// 2026.10.17 by BillyDu
+#include "LaneIndex.h"
+
+#include <algorithm>
+#include <cmath>
+
+LaneIndex::LaneIndex(const SimZombieStore& zombies, const LawnGeometry& geometry)
+    : _zombies(zombies)
+    , _geometry(geometry)
+    , _maxHalfHitWidth(0.0f)
+{
+}
+
+void LaneIndex::clear() {
+    for (int row = 0; row < MAX_GRID_ROWS; ++row) {
+        _lanes[row].clear();
+        _threats[row] = LaneThreat();
+    }
+    _maxHalfHitWidth = 0.0f;
+}
+
+void LaneIndex::insert(size_t zombie) {
+    int row = _zombies.row[zombie];
+    if (row < 0 || row >= MAX_GRID_ROWS) return;
+
+    auto& lane = _lanes[row];
+    const std::vector<float>& xs = _zombies.x;
+    auto it = std::upper_bound(lane.begin(), lane.end(), xs[zombie], [&xs](float value, uint32_t z) {
+        return value < xs[z];
+    });
+    lane.insert(it, (uint32_t)zombie);
+    _maxHalfHitWidth = std::max(_maxHalfHitWidth, _zombies.data[zombie]->hitWidth / 2);
+    refreshThreat(row);
+}
+
+void LaneIndex::remove(size_t zombie) {
+    int row = _zombies.row[zombie];
+    if (row < 0 || row >= MAX_GRID_ROWS) return;
+
+    auto it = locate(zombie);
+    if (it != _lanes[row].end()) {
+        _lanes[row].erase(it);
+        refreshThreat(row);
+    }
+}
+
+void LaneIndex::renumber(size_t from, size_t to) {
+    int row = _zombies.row[from];
+    if (row < 0 || row >= MAX_GRID_ROWS) return;
+
+    auto it = locate(from);
+    if (it != _lanes[row].end()) *it = (uint32_t)to;
+}
+
+std::vector<uint32_t>::iterator LaneIndex::locate(size_t zombie) {
+    auto& lane = _lanes[_zombies.row[zombie]];
+    float x = _zombies.x[zombie];
+    for (auto it = lane.begin() + lowerBound(_zombies.row[zombie], x); it != lane.end() && _zombies.x[*it] <= x; ++it) {
+        if (*it == zombie) return it;
+    }
+    // Not where its X says (lane not re-sorted yet): fall back to a scan
+    return std::find(lane.begin(), lane.end(), (uint32_t)zombie);
+}
+
+void LaneIndex::resort() {
+    const std::vector<float>& xs = _zombies.x;
+    for (int row = 0; row < MAX_GRID_ROWS; ++row) {
+        auto& lane = _lanes[row];
+        for (size_t i = 1; i < lane.size(); ++i) {
+            uint32_t zombie = lane[i];
+            float x = xs[zombie];
+            size_t j = i;
+            while (j > 0 && x < xs[lane[j - 1]]) {
+                lane[j] = lane[j - 1];
+                --j;
+            }
+            lane[j] = zombie;
+        }
+        refreshThreat(row);
+    }
+}
+
+void LaneIndex::refreshThreat(int row) {
+    const auto& lane = _lanes[row];
+    LaneThreat& threat = _threats[row];
+    threat.count = static_cast<int>(lane.size());
+    if (!lane.empty()) {
+        threat.leftmostX = _zombies.x[lane.front()];
+        threat.rightmostX = _zombies.x[lane.back()];
+    }
+}
+
+size_t LaneIndex::lowerBound(int row, float x) const {
+    const auto& lane = _lanes[row];
+    const std::vector<float>& xs = _zombies.x;
+    auto it = std::lower_bound(lane.begin(), lane.end(), x, [&xs](uint32_t z, float value) {
+        return xs[z] < value;
+    });
+    return static_cast<size_t>(it - lane.begin());
+}
+
+size_t LaneIndex::findFirstOverlap(int row, float x, float halfWidth) const {
+    if (row < 0 || row >= MAX_GRID_ROWS) return NONE;
+
+    const auto& lane = _lanes[row];
+    float window = halfWidth + _maxHalfHitWidth;
+    for (size_t i = lowerBound(row, x - window); i < lane.size() && _zombies.x[lane[i]] <= x + window; ++i) {
+        uint32_t zombie = lane[i];
+        if (_zombies.isDead(zombie)) continue;
+        if (std::abs(x - _zombies.x[zombie]) <= halfWidth + _zombies.data[zombie]->hitWidth / 2) {
+            return zombie;
+        }
+    }
+    return NONE;
+}
+
+void LaneIndex::queryLane(int row, float minX, float maxX, std::vector<uint32_t>& out) const {
+    out.clear();
+    if (row < 0 || row >= MAX_GRID_ROWS) return;
+
+    const auto& lane = _lanes[row];
+    for (size_t i = lowerBound(row, minX); i < lane.size() && _zombies.x[lane[i]] < maxX; ++i) {
+        if (_zombies.x[lane[i]] > minX) out.push_back(lane[i]);
+    }
+}
+
+void LaneIndex::queryCells(int row0, int row1, int col0, int col1, float reach,
+                           std::vector<uint32_t>& out) const {
+    out.clear();
+    row0 = std::max(row0, 0);
+    row1 = std::min(row1, _geometry.rows - 1);
+    col0 = std::max(col0, 0);
+    col1 = std::min(col1, GRID_COLS - 1);
+    float halfWidth = _geometry.cellWidth * reach;
+    float halfHeight = _geometry.cellHeight * reach;
+
+    for (int row = row0; row <= row1; ++row) {
+        const auto& lane = _lanes[row];
+        float centerY = _geometry.cellCenterY(row);
+        for (int col = col0; col <= col1; ++col) {
+            float centerX = _geometry.cellCenterX(col);
+            // Same distance test as a scan over every zombie, but only over this window of the lane
+            for (size_t i = lowerBound(row, centerX - halfWidth); i < lane.size(); ++i) {
+                uint32_t zombie = lane[i];
+                float dx = std::abs(_zombies.x[zombie] - centerX);
+                if (dx >= halfWidth) {
+                    if (_zombies.x[zombie] > centerX) break;
+                    continue;
+                }
+                if (std::abs(_zombies.y[zombie] - centerY) < halfHeight) out.push_back(zombie);
+            }
+        }
+    }
+}
+
+void LaneIndex::queryRadius(float x, float y, float radius, std::vector<uint32_t>& out) const {
+    out.clear();
+    float radiusSq = radius * radius;
+    for (int row = 0; row < MAX_GRID_ROWS; ++row) {
+        const auto& lane = _lanes[row];
+        for (size_t i = lowerBound(row, x - radius); i < lane.size() && _zombies.x[lane[i]] <= x + radius; ++i) {
+            uint32_t zombie = lane[i];
+            float dx = _zombies.x[zombie] - x;
+            float dy = _zombies.y[zombie] - y;
+            if (dx * dx + dy * dy <= radiusSq) out.push_back(zombie);
+        }
+    }
+}
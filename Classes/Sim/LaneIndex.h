@@ -0,0 +1,75 @@
+// Per-row index of live zombies sorted by X, so a bullet only looks at the zombies next to it,
+// and the lawn's area queries (explosions, Spikeweed) only touch the zombies they hit
+// 2026.10.17 by BillyDu
+#ifndef __LANE_INDEX_H__
+#define __LANE_INDEX_H__
+
+#include <cstdint>
+#include <vector>
+
+#include "EntityStore.h"
+
+// Per-row summary of live zombies, kept current so shooters can ask "anything ahead?" in O(1)
+struct LaneThreat {
+    int count = 0;
+    float leftmostX = 0.0f;   // valid only when count > 0
+    float rightmostX = 0.0f;
+};
+
+// Lanes hold indices into the zombie store and read positions from it
+class LaneIndex {
+public:
+    static const size_t NONE = (size_t)-1;
+
+    LaneIndex(const SimZombieStore& zombies, const LawnGeometry& geometry);
+
+    void clear();
+    void setGeometry(const LawnGeometry& geometry) { _geometry = geometry; }
+
+    // Spawned zombies enter their lane in X order; dead zombies leave it right away
+    void insert(size_t zombie);
+    void remove(size_t zombie);
+    // The store is about to move zombie `from` to index `to` (swap-and-pop)
+    void renumber(size_t from, size_t to);
+
+    // Restore X order after movement. Zombies barely overtake each other, so lanes stay
+    // nearly sorted and an insertion sort is linear in practice
+    void resort();
+
+    // Leftmost live zombie in the row whose hit box overlaps [x - halfWidth, x + halfWidth], NONE if none
+    size_t findFirstOverlap(int row, float x, float halfWidth) const;
+
+    // Zombie indices of one row, ascending X
+    const std::vector<uint32_t>& getLane(int row) const { return _lanes[row]; }
+    // Position in getLane(row) of the first zombie with X >= x
+    size_t lowerBound(int row, float x) const;
+
+    // Threat table, rebuilt by resort() once per tick and patched on insert / remove
+    const LaneThreat& getThreat(int row) const { return _threats[row]; }
+
+    // --- Area queries ---
+    // Each clears `out` and fills it with zombie indices (lane X order within a row). Nothing is
+    // damaged while querying, so callers can kill the hits afterwards; cost is O(log n + hits)
+    // Live zombies of one row with minX < x < maxX
+    void queryLane(int row, float minX, float maxX, std::vector<uint32_t>& out) const;
+    // Live zombies near the cells [row0..row1] x [col0..col1] (clipped to the lawn): a zombie
+    // matches a cell when |x - centerX| < reach * cellWidth and |y - centerY| < reach * cellHeight.
+    // Cells are visited row by row, left to right, and a zombie is listed once per cell it matches
+    // (reach 0.5 = inside the cell, windows never overlap; larger reaches can repeat a zombie)
+    void queryCells(int row0, int row1, int col0, int col1, float reach, std::vector<uint32_t>& out) const;
+    // Live zombies whose position is within radius of (x, y)
+    void queryRadius(float x, float y, float radius, std::vector<uint32_t>& out) const;
+
+private:
+    void refreshThreat(int row);
+    // Position of a zombie in its lane (binary search on X, then the ties)
+    std::vector<uint32_t>::iterator locate(size_t zombie);
+
+    const SimZombieStore& _zombies;
+    LawnGeometry _geometry;
+    std::vector<uint32_t> _lanes[MAX_GRID_ROWS];
+    LaneThreat _threats[MAX_GRID_ROWS];
+    float _maxHalfHitWidth;  // widest zombie seen so far, bounds the search window
+};
+
+#endif // __LANE_INDEX_H__
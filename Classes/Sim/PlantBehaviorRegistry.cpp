@@ -0,0 +1,93 @@
+// Plant behavior registry
+// 2026.10.17 by BillyDu
+#include "PlantBehaviorRegistry.h"
+
+namespace {
+    template <typename T>
+    struct NamedValue {
+        const char* name;
+        T value;
+    };
+
+    const NamedValue<PlantCategory> CATEGORIES[] = {
+        { "shooter", PlantCategory::SHOOTER },
+        { "producer", PlantCategory::PRODUCER },
+        { "instant", PlantCategory::INSTANT },
+        { "defensive", PlantCategory::DEFENSIVE },
+        { "support", PlantCategory::SUPPORT },
+    };
+
+    // Same order as PlantBehaviorKind (kindName indexes it)
+    const NamedValue<PlantBehaviorKind> KINDS[] = {
+        { "none", PlantBehaviorKind::NONE },
+        { "shooter", PlantBehaviorKind::SHOOTER },
+        { "producer", PlantBehaviorKind::PRODUCER },
+        { "spikes", PlantBehaviorKind::SPIKES },
+        { "bomb", PlantBehaviorKind::BOMB },
+        { "mine", PlantBehaviorKind::MINE },
+        { "eater", PlantBehaviorKind::EATER },
+        { "platform", PlantBehaviorKind::PLATFORM },
+    };
+    static_assert(sizeof(KINDS) / sizeof(KINDS[0]) == (size_t)PlantBehaviorKind::COUNT,
+                  "every PlantBehaviorKind needs a name");
+
+    const NamedValue<ProjectileKind> PROJECTILES[] = {
+        { "pea", ProjectileKind::PEA },
+        { "ice_pea", ProjectileKind::ICE_PEA },
+        { "mushroom", ProjectileKind::MUSHROOM },
+    };
+
+    const NamedValue<ExplosionKind> AOES[] = {
+        { "3x3", ExplosionKind::CHERRY_BOMB },
+        { "lane", ExplosionKind::POTATO_MINE },
+    };
+
+    template <typename T, size_t N>
+    bool lookup(const NamedValue<T> (&table)[N], const std::string& name, T& value) {
+        for (const NamedValue<T>& entry : table) {
+            if (name == entry.name) {
+                value = entry.value;
+                return true;
+            }
+        }
+        return false;
+    }
+}
+
+PlantCategory PlantBehaviorRegistry::categoryFromName(const std::string& name) {
+    PlantCategory category = PlantCategory::UNKNOWN;
+    lookup(CATEGORIES, name, category);
+    return category;
+}
+
+bool PlantBehaviorRegistry::parse(PlantCategory category, const PlantBehaviorFields* fields, PlantBehavior& behavior,
+                                  std::string& error) {
+    if (!fields) {
+        // Plain shooters (one pea) and producers keep working without a "behavior" object; anything
+        // else would silently become an inert plant
+        behavior = PlantBehavior();
+        switch (category) {
+        case PlantCategory::SHOOTER: behavior.kind = PlantBehaviorKind::SHOOTER; return true;
+        case PlantCategory::PRODUCER: behavior.kind = PlantBehaviorKind::PRODUCER; return true;
+        case PlantCategory::UNKNOWN: return true;
+        default:
+            error = "missing \"behavior\" (required for instant, defensive and support plants)";
+            return false;
+        }
+    }
+
+    behavior = fields->params;
+    if (!lookup(KINDS, fields->kind, behavior.kind) ||
+        !lookup(PROJECTILES, fields->projectile, behavior.projectile) ||
+        !lookup(AOES, fields->aoe, behavior.aoe)) {
+        error = "unknown behavior (kind '" + fields->kind + "', projectile '" + fields->projectile +
+                "', aoe '" + fields->aoe + "')";
+        return false;
+    }
+    return true;
+}
+
+const char* PlantBehaviorRegistry::kindName(PlantBehaviorKind kind) {
+    size_t index = (size_t)kind;
+    return index < sizeof(KINDS) / sizeof(KINDS[0]) ? KINDS[index].name : "unknown";
+}
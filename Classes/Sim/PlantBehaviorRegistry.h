@@ -0,0 +1,34 @@
+// Plant behavior registry: plants.json names a behavior ("behavior": {"kind": ...}) and its parameters,
+// the loaders intern every string through here once, and the simulation only dispatches on the enums
+// 2026.10.17 by BillyDu
+#ifndef __PLANT_BEHAVIOR_REGISTRY_H__
+#define __PLANT_BEHAVIOR_REGISTRY_H__
+
+#include <string>
+
+#include "../Entities/GameDataStructures.h"
+
+// A plants.json "behavior" object as read by a loader (DataManager: rapidjson, SimDataLoader: SimJson);
+// keys missing from the object keep these defaults
+struct PlantBehaviorFields {
+    std::string kind = "none";
+    std::string projectile = "pea";
+    std::string aoe = "3x3";             // "3x3" (CherryBomb) or "lane" (PotatoMine)
+    PlantBehavior params;                // volley, volleyDelay, fuse, eatCooldown, crushDamage
+};
+
+class PlantBehaviorRegistry {
+public:
+    // "shooter" / "producer" / ... (UNKNOWN for anything else)
+    static PlantCategory categoryFromName(const std::string& name);
+
+    // The one set of loading rules for both loaders. fields == nullptr: the entry has no "behavior"
+    // object, which only plain shooters and producers may omit; an instant, defensive or support
+    // plant without one, or an unregistered name, is a load error
+    static bool parse(PlantCategory category, const PlantBehaviorFields* fields, PlantBehavior& behavior,
+                      std::string& error);
+
+    static const char* kindName(PlantBehaviorKind kind);
+};
+
+#endif // __PLANT_BEHAVIOR_REGISTRY_H__
@@ -0,0 +1,30 @@
+// Per-game mutable state of a Simulation, apart from the entities themselves:
+// level timeline and cursor, RNG, clocks, sun and cooldowns (ready ticks, nothing counts down per tick)
+// Nothing here is static or global, so simulations never see each other's state
+// 2026.10.17 by BillyDu
+#ifndef __SIM_CONTEXT_H__
+#define __SIM_CONTEXT_H__
+
+#include <random>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "SimTypes.h"
+
+struct SimContext {
+    // Level timeline (sorted by time) and cursor
+    std::vector<SpawnEvent> waves;
+    size_t nextWave = 0;
+
+    std::mt19937 rng;
+    float time = 0.0f;
+    SimTick tickCount = 0;
+    int sun = 500;
+    SimId nextId = 1;
+
+    // Seed card cooldowns keyed by plant ID: tick the card is ready again, total seconds
+    std::unordered_map<int, std::pair<SimTick, float>> cardCooldowns;
+};
+
+#endif // __SIM_CONTEXT_H__
@@ -0,0 +1,167 @@
+// SimDataLoader implementation
+// 2026.10.17 by BillyDu
+#include "SimDataLoader.h"
+#include "PlantBehaviorRegistry.h"
+#include "SimJson.h"
+
+#include <cstdlib>
+
+namespace {
+    // "behavior" object of a plants.json entry; the rules live in PlantBehaviorRegistry::parse
+    bool loadBehavior(const JsonValue& val, const std::string& id, PlantData& data, std::string& error) {
+        const JsonValue* behavior = val.find("behavior");
+        if (behavior && !behavior->isObject()) behavior = nullptr;  // like DataManager: only an object counts
+        PlantBehaviorFields fields;
+        if (behavior) {
+            fields.kind = behavior->getString("kind", fields.kind);
+            fields.projectile = behavior->getString("projectile", fields.projectile);
+            fields.aoe = behavior->getString("aoe", fields.aoe);
+            PlantBehavior& p = fields.params;
+            p.volley = behavior->getInt("volley", p.volley);
+            p.volleyDelay = behavior->getFloat("volleyDelay", p.volleyDelay);
+            p.fuse = behavior->getFloat("fuse", p.fuse);
+            p.eatCooldown = behavior->getFloat("eatCooldown", p.eatCooldown);
+            p.crushDamage = behavior->getInt("crushDamage", p.crushDamage);
+        }
+        std::string reason;
+        if (!PlantBehaviorRegistry::parse(data.category, behavior ? &fields : nullptr, data.behavior, reason)) {
+            error = "Plant " + id + " (" + data.name + "): " + reason;
+            return false;
+        }
+        return true;
+    }
+}
+
+bool SimDataLoader::loadPlants(const std::string& path, std::unordered_map<int, PlantData>& plants, std::string& error) {
+    JsonValue doc;
+    if (!JsonValue::parseFile(path, doc, error)) return false;
+    if (!doc.isObject()) {
+        error = "Invalid JSON format in " + path;
+        return false;
+    }
+
+    for (const auto& member : doc.getMembers()) {
+        int id = atoi(member.first.c_str());
+        const JsonValue& val = member.second;
+        if (!val.find("name")) {
+            error = "Missing 'name' in plant " + member.first;
+            return false;
+        }
+
+        PlantData data;
+        data.name = val.getString("name", "");
+        data.type = val.getString("type", "unknown");
+        data.category = PlantBehaviorRegistry::categoryFromName(data.type);
+        data.hp = val.getInt("hp", 0);
+        data.cost = val.getInt("cost", 0);
+        data.cooldown = val.getFloat("cooldown", 0.0f);
+        data.attack = val.getInt("attack", 0);
+        data.texturePath = val.getString("texture", "");
+        data.attackSpeed = val.getFloat("attackSpeed", 0.0f);
+        // Producers only have produceInterval (same fallback as DataManager::loadPlants)
+        if (data.attackSpeed <= 0.0f) {
+            data.attackSpeed = val.getFloat("produceInterval", 0.0f);
+        }
+        data.defaultAnimation = val.getString("defaultAnimation", "");
+        if (!loadBehavior(val, member.first, data, error)) return false;
+        plants[id] = data;
+    }
+    return true;
+}
+
+bool SimDataLoader::loadZombies(const std::string& path, std::unordered_map<int, ZombieData>& zombies, std::string& error) {
+    JsonValue doc;
+    if (!JsonValue::parseFile(path, doc, error)) return false;
+    if (!doc.isObject()) {
+        error = "Invalid JSON format in " + path;
+        return false;
+    }
+
+    for (const auto& member : doc.getMembers()) {
+        int id = atoi(member.first.c_str());
+        const JsonValue& val = member.second;
+
+        ZombieData data;
+        data.name = val.getString("name", "Unknown");
+        data.hp = val.getInt("hp", 100);
+        data.damage = val.getInt("damage", 10);
+        data.speed = val.getFloat("speed", 10.0f);
+        data.attackInterval = val.getFloat("attackInterval", 1.0f);
+        data.hitWidth = val.getFloat("hitWidth", data.hitWidth);
+        data.texturePath = val.getString("texture", "");
+        data.defaultAnimation = val.getString("defaultAnimation", "");
+        zombies[id] = data;
+    }
+    return true;
+}
+
+bool SimDataLoader::loadWaves(const std::string& path, std::vector<SpawnEvent>& waves, std::string& error) {
+    JsonValue doc;
+    if (!JsonValue::parseFile(path, doc, error)) return false;
+
+    waves.clear();
+    const JsonValue* list = doc.find("waves");
+    if (!list || !list->isArray()) {
+        error = path + ": expected a \"waves\" array";
+        return false;
+    }
+    for (size_t i = 0; i < list->size(); ++i) {
+        const JsonValue& w = (*list)[i];
+        if (!w.isObject() || !w.find("zombieId") || !w.find("row")) {
+            error = path + ": wave " + std::to_string(i) + " needs \"zombieId\" and \"row\"";
+            return false;
+        }
+        SpawnEvent evt;
+        evt.time = w.getFloat("time", 0.0f);
+        evt.zombieId = w.getInt("zombieId", 0);
+        evt.row = w.getInt("row", 0);
+        evt.spawned = false;
+        waves.push_back(evt);
+    }
+    return true;
+}
+
+bool SimDataLoader::validateWaves(const std::vector<SpawnEvent>& waves, const SimDataSnapshot& data,
+                                  const LawnGeometry& geometry, std::string& error) {
+    for (size_t i = 0; i < waves.size(); ++i) {
+        const SpawnEvent& evt = waves[i];
+        if (!data.findZombie(evt.zombieId)) {
+            error = "Wave " + std::to_string(i) + ": unknown zombie " + std::to_string(evt.zombieId);
+            return false;
+        }
+        if (evt.row < 0 || evt.row >= geometry.rows) {
+            error = "Wave " + std::to_string(i) + ": row " + std::to_string(evt.row) + " is outside the " +
+                    std::to_string(geometry.rows) + "-row lawn";
+            return false;
+        }
+    }
+    return true;
+}
+
+bool SimDataLoader::loadTerrain(const std::string& path, LawnTerrain& terrain, std::string& error) {
+    JsonValue doc;
+    if (!JsonValue::parseFile(path, doc, error)) return false;
+
+    terrain = LawnTerrain();
+    const JsonValue* section = doc.find("terrain");
+    const JsonValue* waterRows = section ? section->find("waterRows") : nullptr;
+    if (!waterRows) return true;
+    if (!waterRows->isArray()) {
+        error = path + ": \"waterRows\" must be an array";
+        return false;
+    }
+    for (size_t i = 0; i < waterRows->size(); ++i) {
+        terrain.setRow((*waterRows)[i].asInt(), TERRAIN_WATER);
+    }
+    return true;
+}
+
+SimDataPtr SimDataLoader::loadSnapshot(const std::string& dataDir, std::string& error) {
+    std::unordered_map<int, PlantData> plants;
+    std::unordered_map<int, ZombieData> zombies;
+    if (!loadPlants(dataDir + "/plants.json", plants, error) ||
+        !loadZombies(dataDir + "/zombies.json", zombies, error)) {
+        return nullptr;
+    }
+    return SimDataSnapshot::create(std::move(plants), std::move(zombies));
+}
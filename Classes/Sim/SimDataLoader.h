@@ -0,0 +1,32 @@
+// Loads plants.json / zombies.json / level JSON into a SimSetup without cocos2d
+// Same fields and defaults as DataManager / LevelManager (animations are view-only and skipped)
+// 2026.10.17 by BillyDu
+#ifndef __SIM_DATA_LOADER_H__
+#define __SIM_DATA_LOADER_H__
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "SimDataSnapshot.h"
+#include "SimTypes.h"
+
+class SimDataLoader {
+public:
+    // Each returns false with a message; paths are plain file paths (no FileUtils search paths)
+    static bool loadPlants(const std::string& path, std::unordered_map<int, PlantData>& plants, std::string& error);
+    static bool loadZombies(const std::string& path, std::unordered_map<int, ZombieData>& zombies, std::string& error);
+    // "waves" must be an array; every wave needs "zombieId" and "row" ("time" defaults to 0)
+    static bool loadWaves(const std::string& path, std::vector<SpawnEvent>& waves, std::string& error);
+    // Every wave names a zombie of the snapshot and a row of the lawn (Simulation::spawnZombie would
+    // otherwise skip it silently, and a level of bad waves is "won")
+    static bool validateWaves(const std::vector<SpawnEvent>& waves, const SimDataSnapshot& data,
+                              const LawnGeometry& geometry, std::string& error);
+    // "terrain" of a level file; a level without it has no water
+    static bool loadTerrain(const std::string& path, LawnTerrain& terrain, std::string& error);
+
+    // plants.json + zombies.json from one directory as a shared snapshot; nullptr with a message on failure
+    static SimDataPtr loadSnapshot(const std::string& dataDir, std::string& error);
+};
+
+#endif // __SIM_DATA_LOADER_H__
@@ -0,0 +1,24 @@
+// Immutable plant / zombie definitions
+// 2026.10.17 by BillyDu
+#include "SimDataSnapshot.h"
+
+#include <utility>
+
+std::shared_ptr<const SimDataSnapshot> SimDataSnapshot::create(PlantTable plants, ZombieTable zombies) {
+    return std::shared_ptr<const SimDataSnapshot>(new SimDataSnapshot(std::move(plants), std::move(zombies)));
+}
+
+SimDataSnapshot::SimDataSnapshot(PlantTable plants, ZombieTable zombies)
+    : _plants(std::move(plants))
+    , _zombies(std::move(zombies)) {
+}
+
+const PlantData* SimDataSnapshot::findPlant(int id) const {
+    auto it = _plants.find(id);
+    return it != _plants.end() ? &it->second : nullptr;
+}
+
+const ZombieData* SimDataSnapshot::findZombie(int id) const {
+    auto it = _zombies.find(id);
+    return it != _zombies.end() ? &it->second : nullptr;
+}
@@ -0,0 +1,37 @@
+// Immutable plant / zombie definitions shared by every Simulation in the process
+// Built once (DataManager for the game, SimDataLoader for the tools) and never modified afterwards,
+// so any number of simulations on any number of threads can read it without locking
+// 2026.10.17 by BillyDu
+#ifndef __SIM_DATA_SNAPSHOT_H__
+#define __SIM_DATA_SNAPSHOT_H__
+
+#include <memory>
+#include <unordered_map>
+
+#include "SimTypes.h"
+
+class SimDataSnapshot {
+public:
+    using PlantTable = std::unordered_map<int, PlantData>;
+    using ZombieTable = std::unordered_map<int, ZombieData>;
+
+    // Takes ownership of the tables; the result can only be read
+    static std::shared_ptr<const SimDataSnapshot> create(PlantTable plants, ZombieTable zombies);
+
+    // nullptr when the ID is unknown
+    const PlantData* findPlant(int id) const;
+    const ZombieData* findZombie(int id) const;
+
+    const PlantTable& getPlants() const { return _plants; }
+    const ZombieTable& getZombies() const { return _zombies; }
+
+private:
+    SimDataSnapshot(PlantTable plants, ZombieTable zombies);
+
+    const PlantTable _plants;
+    const ZombieTable _zombies;
+};
+
+using SimDataPtr = std::shared_ptr<const SimDataSnapshot>;
+
+#endif // __SIM_DATA_SNAPSHOT_H__
@@ -0,0 +1,111 @@
+// Typed game events: the Simulation pushes them while it mutates the lawn and hands them to
+// SimCallbacks in one batch per tick (and after each player command), so listeners never run
+// in the middle of an entity loop; also the single place where game events are counted
+// 2026.10.17 by BillyDu
+#ifndef __SIM_EVENTS_H__
+#define __SIM_EVENTS_H__
+
+#include <vector>
+
+#include "SimTypes.h"
+
+enum class SimEventType {
+    ZOMBIE_SPAWNED,
+    ZOMBIE_DAMAGED,     // amount = damage
+    ZOMBIE_KILLED,
+    PLANT_PLACED,
+    PLANT_DAMAGED,      // amount = damage
+    PLANT_ACTION,       // action = animation name
+    PLANT_DESTROYED,    // killed = false when dug up / used up
+    SHOT_FIRED,
+    BULLET_REMOVED,
+    SUN_PRODUCED,
+    SUN_EXPIRED,
+    EXPLOSION,          // explosion, x, y
+    ICE_PLACED,         // row, col
+    COUNT
+};
+
+// One event; only the fields of its type are set. Zombies and plants are referenced by handle;
+// bullet indices and sun pointers stay valid until the batch is drained, because dead entities
+// are only erased after that
+struct SimEvent {
+    SimEventType type = SimEventType::COUNT;
+    SimHandle zombie;
+    SimHandle plant;
+    int bullet = -1;                  // index in SimBulletStore
+    const SimSun* sun = nullptr;      // nullptr for SUN_PRODUCED with autoCollectSun (amount, x, y set)
+    const char* action = nullptr;
+    ExplosionKind explosion = ExplosionKind::CHERRY_BOMB;
+    int amount = 0;
+    bool killed = false;
+    int row = 0;
+    int col = 0;
+    float x = 0.0f;
+    float y = 0.0f;
+};
+
+class SimEventQueue {
+public:
+    static const int TYPE_COUNT = static_cast<int>(SimEventType::COUNT);
+
+    SimEventQueue() {
+        for (int i = 0; i < TYPE_COUNT; ++i) _totals[i] = 0;
+    }
+
+    // Append an event and return it for filling in (valid until the next push)
+    SimEvent& push(SimEventType type) {
+        _events.push_back(SimEvent());
+        SimEvent& event = _events.back();
+        event.type = type;
+        ++_totals[static_cast<int>(type)];
+        return event;
+    }
+
+    bool empty() const { return _events.empty(); }
+
+    // Pending events and totals back to zero (Simulation::reset)
+    void clear() {
+        _events.clear();
+        for (int i = 0; i < TYPE_COUNT; ++i) _totals[i] = 0;
+    }
+
+    // Hand every pending event to fn in push order; events pushed by fn join the same batch.
+    // The buffer keeps its capacity, so a steady game does not allocate here
+    template <typename Fn>
+    void drain(Fn&& fn) {
+        for (size_t i = 0; i < _events.size(); ++i) {
+            SimEvent event = _events[i];
+            fn(event);
+        }
+        _events.clear();
+    }
+
+    // Events pushed since the Simulation started, per type
+    unsigned long long getTotal(SimEventType type) const { return _totals[static_cast<int>(type)]; }
+
+    static const char* getTypeName(SimEventType type) {
+        switch (type) {
+        case SimEventType::ZOMBIE_SPAWNED:  return "zombie spawned";
+        case SimEventType::ZOMBIE_DAMAGED:  return "zombie damaged";
+        case SimEventType::ZOMBIE_KILLED:   return "zombie killed";
+        case SimEventType::PLANT_PLACED:    return "plant placed";
+        case SimEventType::PLANT_DAMAGED:   return "plant damaged";
+        case SimEventType::PLANT_ACTION:    return "plant action";
+        case SimEventType::PLANT_DESTROYED: return "plant destroyed";
+        case SimEventType::SHOT_FIRED:      return "shot fired";
+        case SimEventType::BULLET_REMOVED:  return "bullet removed";
+        case SimEventType::SUN_PRODUCED:    return "sun produced";
+        case SimEventType::SUN_EXPIRED:     return "sun expired";
+        case SimEventType::EXPLOSION:       return "explosion";
+        case SimEventType::ICE_PLACED:      return "ice placed";
+        default:                            return "?";
+        }
+    }
+
+private:
+    std::vector<SimEvent> _events;
+    unsigned long long _totals[TYPE_COUNT];
+};
+
+#endif // __SIM_EVENTS_H__
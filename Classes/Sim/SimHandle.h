@@ -0,0 +1,90 @@
+// 32-bit generational handles for sim entities: a slot index plus a generation that changes every
+// time the slot is reused, so a handle to a removed entity is recognized in O(1) instead of
+// dangling. Grid cells, timers and events hold handles; the table maps them to store indices
+// 2026.10.17 by BillyDu
+#ifndef __SIM_HANDLE_H__
+#define __SIM_HANDLE_H__
+
+#include <cstdint>
+#include <vector>
+
+// 20-bit slot (about a million live entities) + 12-bit generation; 0 = no entity
+struct SimHandle {
+    static const uint32_t SLOT_BITS = 20;
+    static const uint32_t SLOT_MASK = (1u << SLOT_BITS) - 1;
+    static const uint32_t GENERATION_MASK = (1u << (32 - SLOT_BITS)) - 1;
+
+    uint32_t value = 0;
+
+    SimHandle() {}
+    SimHandle(uint32_t slot, uint32_t generation) : value((generation << SLOT_BITS) | slot) {}
+
+    uint32_t slot() const { return value & SLOT_MASK; }
+    uint32_t generation() const { return value >> SLOT_BITS; }
+    // Refers to some entity (which may be gone since, see HandleTable::lookup)
+    bool isSet() const { return value != 0; }
+
+    bool operator==(const SimHandle& other) const { return value == other.value; }
+    bool operator!=(const SimHandle& other) const { return value != other.value; }
+};
+
+// Handle -> index in a dense store. Stores call relocate() when they move an entity
+class HandleTable {
+public:
+    static const uint32_t NONE = 0xFFFFFFFFu;
+
+    SimHandle create(uint32_t index) {
+        uint32_t slot;
+        if (!_freeSlots.empty()) {
+            slot = _freeSlots.back();
+            _freeSlots.pop_back();
+        }
+        else {
+            slot = static_cast<uint32_t>(_slots.size());
+            _slots.push_back(Slot());
+        }
+        Slot& s = _slots[slot];
+        s.index = index;
+        return SimHandle(slot, s.generation);
+    }
+
+    // The slot's generation moves on, so every copy of the handle goes stale at once
+    void destroy(SimHandle handle) {
+        if (lookup(handle) == NONE) return;
+        Slot& s = _slots[handle.slot()];
+        s.index = NONE;
+        s.generation = (s.generation + 1) & SimHandle::GENERATION_MASK;
+        if (s.generation == 0) s.generation = 1;  // generation 0 would make slot 0 look like "no entity"
+        _freeSlots.push_back(handle.slot());
+    }
+
+    void relocate(SimHandle handle, uint32_t index) {
+        if (lookup(handle) != NONE) _slots[handle.slot()].index = index;
+    }
+
+    // Store index of a live entity, NONE for an unset or stale handle
+    uint32_t lookup(SimHandle handle) const {
+        uint32_t slot = handle.slot();
+        if (!handle.isSet() || slot >= _slots.size()) return NONE;
+        const Slot& s = _slots[slot];
+        return s.generation == handle.generation() ? s.index : NONE;
+    }
+
+    bool isAlive(SimHandle handle) const { return lookup(handle) != NONE; }
+
+    // Forget every slot (generations start over, so only do this when no handle is kept)
+    void clear() {
+        _slots.clear();
+        _freeSlots.clear();
+    }
+
+private:
+    struct Slot {
+        uint32_t index = NONE;
+        uint32_t generation = 1;
+    };
+    std::vector<Slot> _slots;
+    std::vector<uint32_t> _freeSlots;
+};
+
+#endif // __SIM_HANDLE_H__
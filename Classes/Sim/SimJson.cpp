@@ -0,0 +1,233 @@
+// JsonValue implementation (recursive descent, UTF-8 passthrough)
+// 2026.10.17 by BillyDu
+#include "SimJson.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+class JsonParser {
+public:
+    explicit JsonParser(const std::string& text) : _text(text) {}
+
+    bool parseDocument(JsonValue& out, std::string& error) {
+        skipWhitespace();
+        if (!parseValue(out, 0)) {
+            error = _error + " at offset " + std::to_string(_pos);
+            return false;
+        }
+        skipWhitespace();
+        if (_pos != _text.size()) {
+            error = "trailing characters at offset " + std::to_string(_pos);
+            return false;
+        }
+        return true;
+    }
+
+private:
+    static const int MAX_DEPTH = 64;
+
+    bool fail(const char* message) {
+        _error = message;
+        return false;
+    }
+
+    void skipWhitespace() {
+        while (_pos < _text.size() && (_text[_pos] == ' ' || _text[_pos] == '\t' || _text[_pos] == '\n' || _text[_pos] == '\r')) {
+            ++_pos;
+        }
+    }
+
+    bool consume(const char* literal) {
+        size_t length = strlen(literal);
+        if (_text.compare(_pos, length, literal) != 0) return false;
+        _pos += length;
+        return true;
+    }
+
+    bool parseValue(JsonValue& out, int depth) {
+        if (depth > MAX_DEPTH) return fail("nesting too deep");
+        if (_pos >= _text.size()) return fail("unexpected end of input");
+
+        char c = _text[_pos];
+        if (c == '{') return parseObject(out, depth);
+        if (c == '[') return parseArray(out, depth);
+        if (c == '"') {
+            out._type = JsonValue::Type::STRING;
+            return parseString(out._string);
+        }
+        if (consume("true")) {
+            out._type = JsonValue::Type::BOOL;
+            out._bool = true;
+            return true;
+        }
+        if (consume("false")) {
+            out._type = JsonValue::Type::BOOL;
+            out._bool = false;
+            return true;
+        }
+        if (consume("null")) {
+            out._type = JsonValue::Type::NUL;
+            return true;
+        }
+        return parseNumber(out);
+    }
+
+    bool parseNumber(JsonValue& out) {
+        const char* begin = _text.c_str() + _pos;
+        char* end = nullptr;
+        double value = strtod(begin, &end);
+        if (end == begin) return fail("unexpected character");
+        _pos += end - begin;
+        out._type = JsonValue::Type::NUMBER;
+        out._number = value;
+        return true;
+    }
+
+    bool parseString(std::string& out) {
+        ++_pos; // opening quote
+        out.clear();
+        while (_pos < _text.size()) {
+            char c = _text[_pos++];
+            if (c == '"') return true;
+            if (c != '\\') {
+                out += c;
+                continue;
+            }
+            if (_pos >= _text.size()) break;
+            char escape = _text[_pos++];
+            switch (escape) {
+            case '"': out += '"'; break;
+            case '\\': out += '\\'; break;
+            case '/': out += '/'; break;
+            case 'b': out += '\b'; break;
+            case 'f': out += '\f'; break;
+            case 'n': out += '\n'; break;
+            case 'r': out += '\r'; break;
+            case 't': out += '\t'; break;
+            case 'u': {
+                if (_pos + 4 > _text.size()) return fail("bad \\u escape");
+                unsigned int code = (unsigned int)strtoul(_text.substr(_pos, 4).c_str(), nullptr, 16);
+                _pos += 4;
+                // BMP only, encoded as UTF-8 (data files are plain ASCII / UTF-8 anyway)
+                if (code < 0x80) {
+                    out += (char)code;
+                }
+                else if (code < 0x800) {
+                    out += (char)(0xC0 | (code >> 6));
+                    out += (char)(0x80 | (code & 0x3F));
+                }
+                else {
+                    out += (char)(0xE0 | (code >> 12));
+                    out += (char)(0x80 | ((code >> 6) & 0x3F));
+                    out += (char)(0x80 | (code & 0x3F));
+                }
+                break;
+            }
+            default:
+                return fail("bad escape");
+            }
+        }
+        return fail("unterminated string");
+    }
+
+    bool parseArray(JsonValue& out, int depth) {
+        ++_pos; // [
+        out._type = JsonValue::Type::ARRAY;
+        skipWhitespace();
+        if (_pos < _text.size() && _text[_pos] == ']') {
+            ++_pos;
+            return true;
+        }
+        while (true) {
+            out._elements.push_back(JsonValue());
+            skipWhitespace();
+            if (!parseValue(out._elements.back(), depth + 1)) return false;
+            skipWhitespace();
+            if (_pos >= _text.size()) return fail("unterminated array");
+            char c = _text[_pos++];
+            if (c == ']') return true;
+            if (c != ',') return fail("expected ',' or ']'");
+        }
+    }
+
+    bool parseObject(JsonValue& out, int depth) {
+        ++_pos; // {
+        out._type = JsonValue::Type::OBJECT;
+        skipWhitespace();
+        if (_pos < _text.size() && _text[_pos] == '}') {
+            ++_pos;
+            return true;
+        }
+        while (true) {
+            skipWhitespace();
+            if (_pos >= _text.size() || _text[_pos] != '"') return fail("expected member name");
+            std::string key;
+            if (!parseString(key)) return false;
+            skipWhitespace();
+            if (_pos >= _text.size() || _text[_pos] != ':') return fail("expected ':'");
+            ++_pos;
+            skipWhitespace();
+            out._members.push_back(std::make_pair(key, JsonValue()));
+            if (!parseValue(out._members.back().second, depth + 1)) return false;
+            skipWhitespace();
+            if (_pos >= _text.size()) return fail("unterminated object");
+            char c = _text[_pos++];
+            if (c == '}') return true;
+            if (c != ',') return fail("expected ',' or '}'");
+        }
+    }
+
+    const std::string& _text;
+    size_t _pos = 0;
+    std::string _error;
+};
+
+bool JsonValue::parse(const std::string& text, JsonValue& out, std::string& error) {
+    out = JsonValue();
+    JsonParser parser(text);
+    return parser.parseDocument(out, error);
+}
+
+bool JsonValue::parseFile(const std::string& path, JsonValue& out, std::string& error) {
+    std::ifstream file(path.c_str(), std::ios::binary);
+    if (!file) {
+        error = "cannot open " + path;
+        return false;
+    }
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    std::string text = buffer.str();
+    // UTF-8 BOM (some data files were saved by Visual Studio)
+    if (text.size() >= 3 && text.compare(0, 3, "\xEF\xBB\xBF") == 0) {
+        text.erase(0, 3);
+    }
+    if (!parse(text, out, error)) {
+        error = path + ": " + error;
+        return false;
+    }
+    return true;
+}
+
+const JsonValue* JsonValue::find(const std::string& key) const {
+    for (const auto& member : _members) {
+        if (member.first == key) return &member.second;
+    }
+    return nullptr;
+}
+
+int JsonValue::getInt(const std::string& key, int fallback) const {
+    const JsonValue* value = find(key);
+    return value && value->isNumber() ? value->asInt() : fallback;
+}
+
+float JsonValue::getFloat(const std::string& key, float fallback) const {
+    const JsonValue* value = find(key);
+    return value && value->isNumber() ? static_cast<float>(value->asNumber()) : fallback;
+}
+
+std::string JsonValue::getString(const std::string& key, const std::string& fallback) const {
+    const JsonValue* value = find(key);
+    return value && value->isString() ? value->asString() : fallback;
+}
@@ -0,0 +1,54 @@
+// Minimal JSON reader for the headless tools (bench, level runner): the game itself uses rapidjson
+// through cocos2d, which headless build boxes do not have
+// 2026.10.17 by BillyDu
+#ifndef __SIM_JSON_H__
+#define __SIM_JSON_H__
+
+#include <string>
+#include <utility>
+#include <vector>
+
+class JsonValue {
+public:
+    enum class Type { NUL, BOOL, NUMBER, STRING, ARRAY, OBJECT };
+
+    // Parse a whole document; false with a message (and offset) on malformed input
+    static bool parse(const std::string& text, JsonValue& out, std::string& error);
+    static bool parseFile(const std::string& path, JsonValue& out, std::string& error);
+
+    Type getType() const { return _type; }
+    bool isObject() const { return _type == Type::OBJECT; }
+    bool isArray() const { return _type == Type::ARRAY; }
+    bool isNumber() const { return _type == Type::NUMBER; }
+    bool isString() const { return _type == Type::STRING; }
+
+    // Object member lookup, nullptr when missing (or not an object)
+    const JsonValue* find(const std::string& key) const;
+    const std::vector<std::pair<std::string, JsonValue>>& getMembers() const { return _members; }
+
+    // Array elements
+    size_t size() const { return _elements.size(); }
+    const JsonValue& operator[](size_t index) const { return _elements[index]; }
+
+    double asNumber() const { return _number; }
+    int asInt() const { return static_cast<int>(_number); }
+    bool asBool() const { return _bool; }
+    const std::string& asString() const { return _string; }
+
+    // Member with a fallback when missing or of another type
+    int getInt(const std::string& key, int fallback) const;
+    float getFloat(const std::string& key, float fallback) const;
+    std::string getString(const std::string& key, const std::string& fallback) const;
+
+private:
+    friend class JsonParser;
+
+    Type _type = Type::NUL;
+    bool _bool = false;
+    double _number = 0.0;
+    std::string _string;
+    std::vector<JsonValue> _elements;
+    std::vector<std::pair<std::string, JsonValue>> _members; // document order
+};
+
+#endif // __SIM_JSON_H__
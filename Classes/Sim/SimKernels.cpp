@@ -0,0 +1,92 @@
+// SimKernels implementation
+// 2026.10.17 by BillyDu
+#include "SimKernels.h"
+
+#if !defined(PVZ_SIM_NO_SIMD) && defined(__AVX2__)
+#define PVZ_SIMD_AVX2 1
+#include <immintrin.h>
+#elif !defined(PVZ_SIM_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define PVZ_SIMD_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace SimKernels {
+
+const char* getIsaName() {
+#if defined(PVZ_SIMD_AVX2)
+    return "avx2";
+#elif defined(PVZ_SIMD_SSE2)
+    return "sse2";
+#else
+    return "scalar";
+#endif
+}
+
+void advanceZombiesScalar(float* x, const float* speed, const float* multiplier, size_t count, float dt) {
+    for (size_t i = 0; i < count; ++i) {
+        x[i] -= speed[i] * multiplier[i] * dt;
+    }
+}
+
+void advanceBulletsScalar(float* x, const float* speed, size_t count, float dt, float maxX,
+                          std::vector<uint32_t>& culled) {
+    for (size_t i = 0; i < count; ++i) {
+        x[i] += speed[i] * dt;
+        if (x[i] > maxX) culled.push_back((uint32_t)i);
+    }
+}
+
+void advanceZombies(float* x, const float* speed, const float* multiplier, size_t count, float dt) {
+    size_t i = 0;
+#if defined(PVZ_SIMD_AVX2)
+    __m256 vdt = _mm256_set1_ps(dt);
+    for (; i + 8 <= count; i += 8) {
+        __m256 step = _mm256_mul_ps(_mm256_mul_ps(_mm256_loadu_ps(speed + i), _mm256_loadu_ps(multiplier + i)), vdt);
+        _mm256_storeu_ps(x + i, _mm256_sub_ps(_mm256_loadu_ps(x + i), step));
+    }
+#elif defined(PVZ_SIMD_SSE2)
+    __m128 vdt = _mm_set1_ps(dt);
+    for (; i + 4 <= count; i += 4) {
+        __m128 step = _mm_mul_ps(_mm_mul_ps(_mm_loadu_ps(speed + i), _mm_loadu_ps(multiplier + i)), vdt);
+        _mm_storeu_ps(x + i, _mm_sub_ps(_mm_loadu_ps(x + i), step));
+    }
+#endif
+    // Tail (or everything without SIMD)
+    advanceZombiesScalar(x + i, speed + i, multiplier + i, count - i, dt);
+}
+
+void advanceBullets(float* x, const float* speed, size_t count, float dt, float maxX,
+                    std::vector<uint32_t>& culled) {
+    size_t i = 0;
+#if defined(PVZ_SIMD_AVX2)
+    __m256 vdt = _mm256_set1_ps(dt);
+    __m256 vmax = _mm256_set1_ps(maxX);
+    for (; i + 8 <= count; i += 8) {
+        __m256 nx = _mm256_add_ps(_mm256_loadu_ps(x + i), _mm256_mul_ps(_mm256_loadu_ps(speed + i), vdt));
+        _mm256_storeu_ps(x + i, nx);
+        // Off-screen bullets are rare: one mask test per 8 bullets
+        int mask = _mm256_movemask_ps(_mm256_cmp_ps(nx, vmax, _CMP_GT_OQ));
+        for (int lane = 0; mask; ++lane, mask >>= 1) {
+            if (mask & 1) culled.push_back((uint32_t)(i + lane));
+        }
+    }
+#elif defined(PVZ_SIMD_SSE2)
+    __m128 vdt = _mm_set1_ps(dt);
+    __m128 vmax = _mm_set1_ps(maxX);
+    for (; i + 4 <= count; i += 4) {
+        __m128 nx = _mm_add_ps(_mm_loadu_ps(x + i), _mm_mul_ps(_mm_loadu_ps(speed + i), vdt));
+        _mm_storeu_ps(x + i, nx);
+        int mask = _mm_movemask_ps(_mm_cmpgt_ps(nx, vmax));
+        for (int lane = 0; mask; ++lane, mask >>= 1) {
+            if (mask & 1) culled.push_back((uint32_t)(i + lane));
+        }
+    }
+#endif
+    // Tail (or everything without SIMD); indices continue from i
+    for (; i < count; ++i) {
+        x[i] += speed[i] * dt;
+        if (x[i] > maxX) culled.push_back((uint32_t)i);
+    }
+}
+
+} // namespace SimKernels
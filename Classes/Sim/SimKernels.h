@@ -0,0 +1,29 @@
+// Vectorized per-tick passes over the entity stores (zombie / bullet advance)
+// AVX2 or SSE2 is picked at compile time (PVZ_SIM_AVX2 for AVX2, SSE2 is the x86-64 baseline);
+// anything else (ARM builds, PVZ_SIM_NO_SIMD) runs the scalar loops. Every path does the same
+// IEEE multiply / add per element as the scalar code, so results are bit-identical
+// 2026.10.17 by BillyDu
+#ifndef __SIM_KERNELS_H__
+#define __SIM_KERNELS_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace SimKernels {
+    // "avx2", "sse2" or "scalar"
+    const char* getIsaName();
+
+    // x[i] -= speed[i] * multiplier[i] * dt (speed 0 = standing still)
+    void advanceZombies(float* x, const float* speed, const float* multiplier, size_t count, float dt);
+    // x[i] += speed[i] * dt; indices whose new X is past maxX are appended to culled (ascending)
+    void advanceBullets(float* x, const float* speed, size_t count, float dt, float maxX,
+                        std::vector<uint32_t>& culled);
+
+    // Plain loops, always available (fallback and benchmark reference)
+    void advanceZombiesScalar(float* x, const float* speed, const float* multiplier, size_t count, float dt);
+    void advanceBulletsScalar(float* x, const float* speed, size_t count, float dt, float maxX,
+                              std::vector<uint32_t>& culled);
+}
+
+#endif // __SIM_KERNELS_H__
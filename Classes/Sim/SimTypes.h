@@ -0,0 +1,199 @@
+// Headless simulation core: plain data types shared by the simulation and the view
+// No cocos2d dependency, so the same code runs in GameScene and on headless build boxes
+// 2026.10.17 by BillyDu
+#ifndef __SIM_TYPES_H__
+#define __SIM_TYPES_H__
+
+#include <cstdio>
+#include <string>
+
+#include "../Consts.h"
+#include "../Entities/GameDataStructures.h"
+#include "SimHandle.h"
+#include "TimerWheel.h"
+
+// Debug logging for the sim core (CCLOG is not available without cocos2d)
+#if defined(COCOS2D_DEBUG) && COCOS2D_DEBUG > 0 || defined(PVZ_SIM_DEBUG)
+#define SIM_LOG(format, ...) fprintf(stderr, format "\n", ##__VA_ARGS__)
+#else
+#define SIM_LOG(...) do {} while (0)
+#endif
+
+// Maximum lawn rows (Map2/Map4 use 6 rows, Map1/Map3 use 5)
+const int MAX_GRID_ROWS = 6;
+
+// Sim entity id, unique within one Simulation (0 = none)
+using SimId = unsigned int;
+
+// Fixed simulation step: GameScene accumulates frame time and ticks in these steps,
+// so results do not depend on the frame rate (the headless tools use the same step)
+const float SIM_TICK_SECONDS = 1.0f / 60.0f;
+// Ticks allowed per rendered frame before the remaining backlog is dropped (long hitches slow the game down)
+const int SIM_MAX_TICKS_PER_FRAME = 8;
+
+// Simulation clock in whole ticks (timer deadlines, cooldowns)
+using SimTick = unsigned long long;
+
+// Whole ticks needed for a duration (a timer never fires before its time is up)
+inline SimTick secondsToTicks(float seconds) {
+    if (seconds <= 0.0f) return 0;
+    // The small slack keeps 1.5 s at 90 ticks instead of 91 through float rounding
+    SimTick ticks = (SimTick)(seconds / SIM_TICK_SECONDS + 0.999f);
+    return ticks > 0 ? ticks : 1;
+}
+
+// Lawn layout in design pixels, shared by grid <-> pixel conversions
+struct LawnGeometry {
+    int rows = GRID_ROWS;
+    float startX = GRID_START_X;
+    float startY = GRID_START_Y;
+    float cellWidth = CELL_WIDTH;
+    float cellHeight = CELL_HEIGHT;
+
+    // Map2/Map4 have 6 rows (pool) with 0.88x cells aligned to the bottom of the screen
+    static LawnGeometry forMap(int mapId, float originY = 0.0f) {
+        LawnGeometry g;
+        if (mapId == 2 || mapId == 4) {
+            g.rows = 6;
+            g.cellHeight = CELL_HEIGHT * 0.88f;
+            g.startY = originY;
+        }
+        return g;
+    }
+
+    float cellCenterX(int col) const { return startX + col * cellWidth + cellWidth / 2; }
+    float cellCenterY(int row) const { return startY + row * cellHeight + cellHeight / 2; }
+
+    // Returns false (row = col = -1) when the point is outside the lawn
+    bool pixelToCell(float x, float y, int& row, int& col) const {
+        col = (int)((x - startX) / cellWidth);
+        row = (int)((y - startY) / cellHeight);
+        if (col < 0 || col >= GRID_COLS || row < 0 || row >= rows) {
+            row = col = -1;
+            return false;
+        }
+        return true;
+    }
+};
+
+// Terrain bits of one lawn cell
+const unsigned char TERRAIN_WATER = 1 << 0;  // pool: plants need a LilyPad, zombies swim
+const unsigned char TERRAIN_ICE = 1 << 1;    // Boss2 ice trail (set during the game)
+
+// Zombie that actually spawns for a wave entry in a water row: Conehead -> DuckConeheadZombie,
+// everything else -> DuckZombie (Simulation::spawnZombie, and the asset preload list)
+inline int swimmingZombieId(int id) {
+    return (id == 2002) ? 2007 : 2006;
+}
+
+// Initial terrain of every cell, from the level file: "terrain": {"waterRows": [2, 3]}
+struct LawnTerrain {
+    unsigned char cells[MAX_GRID_ROWS][GRID_COLS];
+
+    LawnTerrain() {
+        for (int r = 0; r < MAX_GRID_ROWS; ++r) setRow(r, 0);
+    }
+
+    void setRow(int row, unsigned char flags) {
+        if (row < 0 || row >= MAX_GRID_ROWS) return;
+        for (int c = 0; c < GRID_COLS; ++c) cells[row][c] = flags;
+    }
+
+    // Zombies entering this row swim (its rightmost cell is water)
+    bool isWaterRow(int row) const {
+        return row >= 0 && row < MAX_GRID_ROWS && (cells[row][GRID_COLS - 1] & TERRAIN_WATER) != 0;
+    }
+
+    // Map2/Map4 pool rows, for callers without a level file (benchmarks)
+    static LawnTerrain forMap(int mapId) {
+        LawnTerrain t;
+        if (mapId == 2 || mapId == 4) {
+            t.setRow(2, TERRAIN_WATER);
+            t.setRow(3, TERRAIN_WATER);
+        }
+        return t;
+    }
+};
+
+enum class ZombieState {
+    WALK,
+    ATTACK,
+    DIE
+};
+
+// One zombie as a plain record; the Simulation keeps zombies and bullets in SimZombieStore /
+// SimBulletStore (struct of arrays) and gathers these for callbacks and the view
+struct SimZombie {
+    SimId id = 0;
+    int typeId = 0;            // final zombie ID (after the pool-row swap)
+    const ZombieData* data = nullptr;  // level archetype (map multipliers applied), owned by the Simulation
+    int row = 0;
+    float x = 0.0f;
+    float y = 0.0f;
+    float prevX = 0.0f;        // position before the last tick (render interpolation)
+    float prevY = 0.0f;
+    int hp = 0;
+    int maxHp = 0;
+    ZombieState state = ZombieState::WALK;
+    bool walk2 = false;            // walk1 -> walk2 (swim) animation, set by a timer after spawning
+    float speedMultiplier = 1.0f;  // 1.0 = normal, 0.5 = slowed by SnowPea
+    int phase = 1;                 // Boss1: 1-2, Boss2: 1-4
+    bool isBoss1 = false;
+    bool isCrushing = false;       // Boss2 (snow sled) never stops, crushes plants
+
+    bool isDead() const { return hp <= 0; }
+    // Position between the last two ticks, alpha in [0, 1]
+    float renderX(float alpha) const { return prevX + (x - prevX) * alpha; }
+    float renderY(float alpha) const { return prevY + (y - prevY) * alpha; }
+};
+
+struct SimPlant {
+    SimId id = 0;              // view key (sprites)
+    SimHandle handle;          // what the grid, timers and events keep instead of a pointer
+    int typeId = 0;            // plant ID from plants.json
+    const PlantData* data = nullptr;   // shared definition in the SimDataSnapshot
+    int row = 0;
+    int col = 0;
+    float x = 0.0f;
+    float y = 0.0f;
+    int hp = 0;
+    TimerHandle skillTimer;    // next shot / sun / spike (cancelled when the plant goes away)
+    SimTick skillAnchor = 0;   // tick of the last skill deadline; waking keeps the same rhythm
+    bool asleep = false;       // shooter / Spikeweed with nothing to hit: no timer until its lane wakes up
+    bool onLilyPad = false;    // stacked on a LilyPad in a pool row
+    SimTick eatReadyTick = 0;  // Chomper: tick it can eat again (digestion)
+
+    bool isDead() const { return hp <= 0; }
+};
+
+struct SimBullet {
+    SimId id = 0;
+    ProjectileKind kind = ProjectileKind::PEA;
+    int row = 0;
+    float x = 0.0f;
+    float y = 0.0f;
+    float prevX = 0.0f;        // position before the last tick (render interpolation)
+    float prevY = 0.0f;
+    int damage = 0;
+    float speed = 400.0f;
+    float slowEffect = 1.0f;   // speed multiplier applied on hit (ICE_PEA only)
+    float hitWidth = 37.0f;    // collision box width (pea texture width)
+    bool active = true;
+
+    float renderX(float alpha) const { return prevX + (x - prevX) * alpha; }
+    float renderY(float alpha) const { return prevY + (y - prevY) * alpha; }
+};
+
+struct SimSun {
+    SimId id = 0;
+    float startX = 0.0f;       // where the view starts the fall / jump
+    float startY = 0.0f;
+    float x = 0.0f;            // resting position
+    float y = 0.0f;
+    int value = 25;
+    TimerHandle expiryTimer;   // uncollected suns expire (fade out) when it fires
+    bool fromSky = false;
+    bool active = true;        // false once expired (erased after the tick's events)
+};
+
+#endif // __SIM_TYPES_H__
@@ -0,0 +1,1062 @@
+// Simulation implementation (ported from GameScene::update / updateCombatLogic / spawnZombie / tryPlantAt)
+// 2026.10.17 by BillyDu
+#include "Simulation.h"
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+
+#include "SimKernels.h"
+
+namespace {
+    const float SKY_SUN_INTERVAL = 10.0f;   // one sun falls every 10 seconds
+    const float SKY_SUN_LIFETIME = 9.0f;    // fall 5s + rest 3s + fade 1s
+    const float PLANT_SUN_LIFETIME = 6.8f;  // jump 0.8s + rest 5s + fade 1s
+    const int SUN_VALUE = 25;
+    const float ZOMBIE_WALK2_DELAY = 15.0f;  // walk1 -> walk2 (swim) animation
+    const int INSTANT_KILL_DAMAGE = 9999;
+    const int DEFAULT_EXPLOSION_DAMAGE = 5000;
+    const float BULLET_MAX_X = 1300.0f;     // screen width is 1280
+}
+
+Simulation::Simulation(const SimSetup& setup)
+    : _mapId(setup.mapId)
+    , _geometry(setup.geometry)
+    , _lanes(_zombies, _geometry)
+{
+    reset(setup);
+}
+
+void Simulation::reset(const SimSetup& setup) {
+    _mapId = setup.mapId;
+    _geometry = setup.geometry;
+    _data = setup.data ? setup.data : SimDataSnapshot::create({}, {});
+    _autoCollectSun = setup.autoCollectSun;
+    _freePlanting = setup.freePlanting;
+    _state = GameState::PLAYING;
+
+    // Entities first: zombies point into _zombieArchetypes, timers into _suns
+    _zombies.clear();
+    _lanes.clear();
+    _lanes.setGeometry(_geometry);
+    _plants.clear();
+    _plantHandles.clear();
+    _bullets.clear();
+    _culledBullets.clear();
+    _areaHits.clear();
+    _suns.clear();
+    _timers.clear();
+    _events.clear();
+    for (auto& sleepers : _sleepingPlants) {
+        sleepers.clear();
+    }
+    _zombieArchetypes.clear();
+
+    _ctx.waves = setup.waves;
+    _ctx.nextWave = 0;
+    _ctx.time = 0.0f;
+    _ctx.tickCount = 0;
+    _ctx.sun = setup.initialSun;
+    _ctx.nextId = 1;
+    _ctx.cardCooldowns.clear();
+    _ctx.rng.seed(setup.seed);
+
+    for (int r = 0; r < MAX_GRID_ROWS; ++r) {
+        for (int c = 0; c < GRID_COLS; ++c) {
+            _cells[r][c] = LawnCell();
+            _cells[r][c].terrain = setup.terrain.cells[r][c];
+        }
+    }
+
+    // The timeline is consumed with a cursor, so keep it ordered by time
+    std::stable_sort(_ctx.waves.begin(), _ctx.waves.end(), [](const SpawnEvent& a, const SpawnEvent& b) {
+        return a.time < b.time;
+    });
+
+    // Cost range of the loadout (for the cooldown formula)
+    _minCost = INT_MAX;
+    _maxCost = 0;
+    for (int id : setup.loadout) {
+        const PlantData* def = _data->findPlant(id);
+        if (!def) {
+            SIM_LOG("[Warn] Loadout plant %d not found", id);
+            continue;
+        }
+        _minCost = std::min(_minCost, def->cost);
+        _maxCost = std::max(_maxCost, def->cost);
+        _ctx.cardCooldowns[id] = std::make_pair(SimTick(0), 0.0f);
+    }
+    // Only one plant, or all plants share the same cost: use the default range
+    if (_minCost == INT_MAX || _minCost == _maxCost) {
+        _minCost = 0;
+        _maxCost = 200;
+    }
+
+    buildZombieArchetypes();
+
+    SimTimer skySun;
+    skySun.kind = SimTimer::Kind::SKY_SUN;
+    scheduleIn(SKY_SUN_INTERVAL, skySun);
+}
+
+void Simulation::buildZombieArchetypes() {
+    // Difficulty multipliers per map (chapter)
+    float hpMultiplier = 1.0f;
+    float speedMultiplier = 1.0f;
+    float damageMultiplier = 1.0f;
+    switch (_mapId) {
+    case 1: // Day 1
+        break;
+    case 2: // Day 2
+        hpMultiplier = 1.3f;
+        speedMultiplier = 1.05f;
+        damageMultiplier = 1.1f;
+        break;
+    case 3: // Night 1
+        hpMultiplier = 1.6f;
+        speedMultiplier = 1.1f;
+        damageMultiplier = 1.2f;
+        break;
+    case 4: // Night 2
+    default:
+        hpMultiplier = 2.0f;
+        speedMultiplier = 1.2f;
+        damageMultiplier = 1.3f;
+        break;
+    }
+
+    for (const auto& entry : _data->getZombies()) {
+        ZombieArchetype& archetype = _zombieArchetypes[entry.first];
+        archetype.data = entry.second;
+        archetype.data.hp = static_cast<int>(archetype.data.hp * hpMultiplier);
+        archetype.data.speed = archetype.data.speed * speedMultiplier;
+        archetype.data.damage = static_cast<int>(archetype.data.damage * damageMultiplier);
+        archetype.isBoss1 = (archetype.data.name == "Boss1");
+        archetype.isCrushing = (archetype.data.name == "Boss2");
+    }
+}
+
+void Simulation::tick(float dt) {
+    if (_state != GameState::PLAYING) return;
+
+    _ctx.time += dt;
+    ++_ctx.tickCount;
+
+    // Remember where moving entities were, the view interpolates from here
+    _zombies.prevX = _zombies.x;
+    _zombies.prevY = _zombies.y;
+    _bullets.prevX = _bullets.x;
+    _bullets.prevY = _bullets.y;
+
+    // 1. Level timeline: spawn zombies whose time has come
+    {
+        PVZ_PROFILE_SCOPE(_profiler, ProfilePhase::WAVES);
+        updateWaves();
+    }
+
+    // 2. Zombies (movement, timers, boss phases)
+    {
+        PVZ_PROFILE_SCOPE(_profiler, ProfilePhase::ZOMBIES);
+        updateZombies(dt);
+    }
+
+    // 3. Due timers only: plant attacks / production, delayed shots, fuses, sun expiry, sky sun
+    {
+        PVZ_PROFILE_SCOPE(_profiler, ProfilePhase::TIMERS);
+        updateTimers();
+    }
+
+    // 4. Bullets
+    {
+        PVZ_PROFILE_SCOPE(_profiler, ProfilePhase::BULLETS);
+        updateBullets(dt);
+    }
+
+    // 5. Combat (bullet hits, zombie bites, Boss2 crushing)
+    updateCombatLogic();
+
+    // 6. This tick's events go to the view in one batch, while every entity they mention still exists
+    {
+        PVZ_PROFILE_SCOPE(_profiler, ProfilePhase::EVENTS);
+        flushEvents();
+    }
+
+    // 7. Dead entities are removed (seed card / Chomper cooldowns are ready ticks, nothing to count down)
+    {
+        PVZ_PROFILE_SCOPE(_profiler, ProfilePhase::CLEANUP);
+        removeDeadEntities();
+    }
+
+    // 8. Victory / game over
+    {
+        PVZ_PROFILE_SCOPE(_profiler, ProfilePhase::END_CHECK);
+        checkEndConditions();
+    }
+}
+
+void Simulation::updateWaves() {
+    while (_ctx.nextWave < _ctx.waves.size() && _ctx.time >= _ctx.waves[_ctx.nextWave].time) {
+        SpawnEvent& evt = _ctx.waves[_ctx.nextWave];
+        spawnZombie(evt.zombieId, evt.row);
+        evt.spawned = true;
+        ++_ctx.nextWave;
+        if (_ctx.nextWave == _ctx.waves.size()) {
+            SIM_LOG("[Info] Level Waves Finished!");
+        }
+    }
+}
+
+void Simulation::spawnZombie(int id, int row) {
+    // 0. Pool rows only spawn swimming zombies
+    int spawnId = isWaterRow(row) ? swimmingZombieId(id) : id;
+
+    auto archetypeIt = _zombieArchetypes.find(spawnId);
+    if (archetypeIt == _zombieArchetypes.end()) {
+        SIM_LOG("[Err] Failed to spawn zombie: Zombie ID not found: %d", spawnId);
+        return;
+    }
+    const ZombieArchetype& archetype = archetypeIt->second;
+
+    if (row < 0 || row >= _geometry.rows) {
+        SIM_LOG("[Warn] Invalid row %d for map %d (max rows: %d), skipping spawn", row, _mapId, _geometry.rows);
+        return;
+    }
+
+    // 1. Only the mutable state is per zombie; the (already scaled) definition is shared
+    SimId zombieId = _ctx.nextId++;
+    size_t z = _zombies.add(zombieId);
+    _zombies.typeId[z] = spawnId;
+    _zombies.data[z] = &archetype.data;
+    _zombies.hp[z] = _zombies.maxHp[z] = archetype.data.hp;
+    _zombies.isBoss1[z] = archetype.isBoss1;
+    _zombies.isCrushing[z] = archetype.isCrushing;
+
+    // 2. Enter from the right edge of the lawn
+    _zombies.row[z] = row;
+    _zombies.x[z] = _zombies.prevX[z] = _geometry.cellCenterX(GRID_COLS) + 50.0f;
+    _zombies.y[z] = _zombies.prevY[z] = _geometry.cellCenterY(row);
+    _zombies.walkSpeed[z] = archetype.data.speed;
+    _zombies.nextBiteTick[z] = _ctx.tickCount + secondsToTicks(archetype.data.attackInterval);
+
+    SimTimer walk2;
+    walk2.kind = SimTimer::Kind::ZOMBIE_WALK2;
+    walk2.zombie = _zombies.handle[z];
+    _zombies.walk2Timer[z] = scheduleIn(ZOMBIE_WALK2_DELAY, walk2);
+
+    _lanes.insert(z);
+    wakeLane(row);
+    _events.push(SimEventType::ZOMBIE_SPAWNED).zombie = _zombies.handle[z];
+
+    SIM_LOG("[Info] Spawned Zombie [origID:%d -> finalID:%d] at Row:%d, MapId:%d (TotalRows:%d)",
+            id, spawnId, row, _mapId, _geometry.rows);
+}
+
+void Simulation::updateZombies(float dt) {
+    // Boss phases (only bosses have them)
+    for (size_t z = 0; z < _zombies.size(); ++z) {
+        if (_zombies.isDead(z) || !(_zombies.isBoss1[z] || _zombies.isCrushing[z])) continue;
+        checkPhaseTransition(z);
+    }
+
+    // Everyone moves in one vectorized pass; eating / dead zombies have walkSpeed 0
+    SimKernels::advanceZombies(_zombies.x.data(), _zombies.walkSpeed.data(), _zombies.speedMultiplier.data(),
+                               _zombies.size(), dt);
+    _lanes.resort();
+}
+
+void Simulation::setZombieState(size_t z, ZombieState state) {
+    _zombies.state[z] = state;
+    // Boss2 (snow sled) always moves forward; walkers stop while eating
+    bool moving = state != ZombieState::DIE && (_zombies.isCrushing[z] || state == ZombieState::WALK);
+    _zombies.walkSpeed[z] = moving ? _zombies.data[z]->speed : 0.0f;
+}
+
+void Simulation::checkPhaseTransition(size_t z) {
+    int maxHp = _zombies.maxHp[z];
+    if (maxHp <= 0) return;
+
+    int hp = _zombies.hp[z];
+    int& phase = _zombies.phase[z];
+    float hpPercent = (float)hp / (float)maxHp * 100.0f;
+
+    // Boss1: 30% threshold (move1/eat1 -> move2/eat2)
+    if (_zombies.isBoss1[z]) {
+        if (phase == 1 && hpPercent <= 30.0f) {
+            phase = 2;
+            SIM_LOG("[Info] Boss1 entered Phase 2! HP: %.1f%% (%d/%d)", hpPercent, hp, maxHp);
+        }
+    }
+    // Boss2: 75% -> move2, 40% -> move3, 20% -> move4
+    else if (_zombies.isCrushing[z]) {
+        int targetPhase = 1;
+        if (hpPercent <= 20.0f) {
+            targetPhase = 4;
+        }
+        else if (hpPercent <= 40.0f) {
+            targetPhase = 3;
+        }
+        else if (hpPercent <= 75.0f) {
+            targetPhase = 2;
+        }
+        if (targetPhase != phase) {
+            SIM_LOG("[Info] Boss2 phase transition: %d -> %d (HP: %.1f%%)", phase, targetPhase, hpPercent);
+            phase = targetPhase;
+        }
+    }
+}
+
+void Simulation::updateTimers() {
+    _timers.advance(_ctx.tickCount, [this](const SimTimer& timer) { onTimer(timer); });
+}
+
+TimerHandle Simulation::scheduleIn(float seconds, const SimTimer& timer) {
+    return _timers.schedule(_ctx.tickCount + secondsToTicks(seconds), timer);
+}
+
+void Simulation::onTimer(const SimTimer& timer) {
+    switch (timer.kind) {
+    case SimTimer::Kind::PLANT_SKILL: {
+        // attackSpeed doubles as the attack / production interval; re-armed before the skill runs
+        SimPlant* owner = getPlant(timer.plant);
+        if (!owner) break;
+        SimPlant& plant = *owner;
+        plant.skillAnchor = _ctx.tickCount;
+        if (!hasSkillTarget(plant)) {
+            sleepPlant(plant);
+            break;
+        }
+        plant.skillTimer = scheduleIn(plant.data->attackSpeed, timer);
+        triggerSkill(plant);
+        break;
+    }
+    case SimTimer::Kind::VOLLEY_SHOT:
+        fireProjectile(timer.projectile, timer.row, timer.x, timer.y, timer.damage);
+        break;
+    case SimTimer::Kind::BOMB_FUSE: {
+        explode(timer.aoe, timer.x, timer.y, timer.damage, timer.row, timer.col);
+        SimPlant* bomb = getPlant(timer.plant);
+        if (bomb && !bomb->isDead()) {
+            removePlant(*bomb, false);
+        }
+        break;
+    }
+    case SimTimer::Kind::SUN_EXPIRY:
+        // Erased in removeDeadEntities, after the event batch
+        timer.sun->expiryTimer = TimerHandle();
+        timer.sun->active = false;
+        _events.push(SimEventType::SUN_EXPIRED).sun = timer.sun;
+        break;
+    case SimTimer::Kind::SKY_SUN: {
+        scheduleIn(SKY_SUN_INTERVAL, timer);
+        float x = GRID_START_X + (_ctx.rng() % (int)(GRID_COLS * CELL_WIDTH));
+        float y = GRID_START_Y + (_ctx.rng() % (int)(_geometry.rows * CELL_HEIGHT));
+        spawnSun(x, DESIGN_RESOLUTION_HEIGHT + 50, x, y, true);
+        break;
+    }
+    case SimTimer::Kind::ZOMBIE_WALK2: {
+        size_t z = _zombies.indexOf(timer.zombie);
+        if (z == SimZombieStore::NONE) break;
+        _zombies.walk2Timer[z] = TimerHandle();
+        _zombies.walk2[z] = 1;
+        break;
+    }
+    }
+}
+
+// Periodic skill per PlantBehaviorKind (nullptr = no skill timer)
+const Simulation::SkillHandler Simulation::SKILL_HANDLERS[] = {
+    nullptr,                      // NONE
+    &Simulation::shooterSkill,    // SHOOTER
+    &Simulation::producerSkill,   // PRODUCER
+    &Simulation::spikesSkill,     // SPIKES
+    nullptr,                      // BOMB (one fuse timer, see tryPlantAt)
+    nullptr,                      // MINE (triggered by zombies)
+    nullptr,                      // EATER (triggered by zombies)
+    nullptr,                      // PLATFORM
+};
+
+void Simulation::triggerSkill(SimPlant& plant) {
+    static_assert(sizeof(SKILL_HANDLERS) / sizeof(SKILL_HANDLERS[0]) == (size_t)PlantBehaviorKind::COUNT,
+                  "one skill handler per PlantBehaviorKind");
+    SkillHandler handler = SKILL_HANDLERS[(int)plant.data->behavior.kind];
+    if (handler) (this->*handler)(plant);
+}
+
+void Simulation::shooterSkill(SimPlant& plant) {
+    const PlantData& data = *plant.data;
+    const PlantBehavior& behavior = data.behavior;
+    if (data.animations.count("shoot")) {
+        pushPlantAction(plant, "shoot");
+    }
+
+    // Bullet spawn position: slightly right and up from the plant center (mouth)
+    float x = plant.x + 20;
+    float y = plant.y + 10;
+
+    // Only fire while a zombie is ahead in this row
+    if (!hasZombieAhead(plant.row, x)) {
+        return;
+    }
+
+    // First projectile now, the rest of the volley (Repeater) slightly later
+    fireProjectile(behavior.projectile, plant.row, x, y, data.attack);
+    SimTimer shot;
+    shot.kind = SimTimer::Kind::VOLLEY_SHOT;
+    shot.projectile = behavior.projectile;
+    shot.row = plant.row;
+    shot.x = x;
+    shot.y = y;
+    shot.damage = data.attack;
+    for (int i = 1; i < behavior.volley; ++i) {
+        scheduleIn(behavior.volleyDelay * i, shot);
+    }
+}
+
+void Simulation::producerSkill(SimPlant& plant) {
+    if (plant.data->animations.count("produce")) {
+        pushPlantAction(plant, "produce");
+    }
+    // Sun jumps out of the plant, landing slightly to the lower right
+    float x = plant.x;
+    float y = plant.y + 20;
+    spawnSun(x, y, x + 30, y - 30, false);
+}
+
+void Simulation::spikesSkill(SimPlant& plant) {
+    if (plant.data->animations.count("attack")) {
+        pushPlantAction(plant, "attack");
+    }
+
+    // Damage every zombie standing on the plant's cell
+    float cellLeft = _geometry.startX + plant.col * _geometry.cellWidth;
+    float cellRight = cellLeft + _geometry.cellWidth;
+    const LaneThreat& threat = _lanes.getThreat(plant.row);
+    if (threat.count == 0 || threat.leftmostX >= cellRight || threat.rightmostX <= cellLeft) {
+        return;
+    }
+
+    _lanes.queryLane(plant.row, cellLeft, cellRight, _areaHits);
+    for (uint32_t z : _areaHits) {
+        // Boss2 is handled by the crushing logic
+        if (_zombies.isCrushing[z]) continue;
+        damageZombie(z, plant.data->attack);
+    }
+}
+
+bool Simulation::hasSkillTarget(const SimPlant& plant) const {
+    switch (plant.data->behavior.kind) {
+    case PlantBehaviorKind::SHOOTER:
+        // Same check as shooterSkill, from the bullet spawn point
+        return hasZombieAhead(plant.row, plant.x + 20);
+    case PlantBehaviorKind::SPIKES:
+        return _lanes.getThreat(plant.row).count > 0;
+    default:
+        return true;
+    }
+}
+
+void Simulation::sleepPlant(SimPlant& plant) {
+    plant.asleep = true;
+    plant.skillTimer = TimerHandle();
+    _sleepingPlants[plant.row].push_back(plant.handle);
+}
+
+void Simulation::wakeLane(int row) {
+    std::vector<SimHandle>& sleepers = _sleepingPlants[row];
+    for (SimHandle handle : sleepers) {
+        SimPlant* plant = getPlant(handle);
+        if (!plant) continue;
+
+        // Next deadline on the grid it slept on, so waking never shifts when a plant fires
+        SimTick interval = secondsToTicks(plant->data->attackSpeed);
+        SimTick elapsed = _ctx.tickCount - plant->skillAnchor;
+        SimTick deadline = plant->skillAnchor + (elapsed + interval - 1) / interval * interval;
+
+        SimTimer skill;
+        skill.kind = SimTimer::Kind::PLANT_SKILL;
+        skill.plant = handle;
+        plant->asleep = false;
+        plant->skillTimer = _timers.schedule(deadline, skill);
+    }
+    sleepers.clear();
+}
+
+bool Simulation::hasZombieAhead(int row, float x) const {
+    if (row < 0 || row >= MAX_GRID_ROWS) return false;
+
+    const LaneThreat& threat = _lanes.getThreat(row);
+    return threat.count > 0 && threat.rightmostX > x;
+}
+
+void Simulation::fireProjectile(ProjectileKind kind, int row, float x, float y, int damage) {
+    size_t b = _bullets.add(_ctx.nextId++);
+    _bullets.kind[b] = kind;
+    _bullets.row[b] = row;
+    _bullets.x[b] = _bullets.prevX[b] = x;
+    _bullets.y[b] = _bullets.prevY[b] = y;
+    _bullets.damage[b] = damage;
+    // Collision widths follow the bullet textures
+    switch (kind) {
+    case ProjectileKind::ICE_PEA:
+        _bullets.slowEffect[b] = 0.5f; // 50% speed
+        _bullets.hitWidth[b] = 56.0f;
+        break;
+    case ProjectileKind::MUSHROOM:
+        _bullets.hitWidth[b] = 66.0f;
+        break;
+    case ProjectileKind::PEA:
+    default:
+        break;
+    }
+
+    _events.push(SimEventType::SHOT_FIRED).bullet = (int)b;
+}
+
+void Simulation::spawnSun(float startX, float startY, float x, float y, bool fromSky) {
+    SimId sunId = _ctx.nextId++;
+    if (_autoCollectSun) {
+        // Credited on the spot, nothing lies on the lawn: the event (totals, trace) has no SimSun
+        SimEvent& produced = _events.push(SimEventType::SUN_PRODUCED);
+        produced.amount = SUN_VALUE;
+        produced.x = x;
+        produced.y = y;
+        _ctx.sun += SUN_VALUE;
+        return;
+    }
+
+    std::unique_ptr<SimSun> sun(new SimSun());
+    sun->id = sunId;
+    sun->startX = startX;
+    sun->startY = startY;
+    sun->x = x;
+    sun->y = y;
+    sun->value = SUN_VALUE;
+    sun->fromSky = fromSky;
+
+    SimTimer expiry;
+    expiry.kind = SimTimer::Kind::SUN_EXPIRY;
+    expiry.sun = sun.get();
+    sun->expiryTimer = scheduleIn(fromSky ? SKY_SUN_LIFETIME : PLANT_SUN_LIFETIME, expiry);
+
+    _suns.push_back(std::move(sun));
+    _events.push(SimEventType::SUN_PRODUCED).sun = _suns.back().get();
+}
+
+void Simulation::updateBullets(float dt) {
+    // Every bullet is active here (only this phase and the hits after it deactivate bullets,
+    // and cleanup removed last tick's), so the whole array advances in one vectorized pass
+    _culledBullets.clear();
+    SimKernels::advanceBullets(_bullets.x.data(), _bullets.speed.data(), _bullets.size(), dt, BULLET_MAX_X,
+                               _culledBullets);
+    for (uint32_t b : _culledBullets) {
+        if (!_bullets.active[b]) continue;
+        _bullets.active[b] = 0;
+        _events.push(SimEventType::BULLET_REMOVED).bullet = (int)b;
+    }
+}
+
+void Simulation::explode(ExplosionKind kind, float x, float y, int damage, int row, int col) {
+    SimEvent& blast = _events.push(SimEventType::EXPLOSION);
+    blast.explosion = kind;
+    blast.x = x;
+    blast.y = y;
+
+    if (kind == ExplosionKind::CHERRY_BOMB) {
+        // CherryBomb: every zombie in the 3x3 cells around the bomb
+        _lanes.queryCells(row - 1, row + 1, col - 1, col + 1, 0.5f, _areaHits);
+    }
+    else {
+        // PotatoMine: same row, current cell and two cells each side with a 1.5x cell window
+        // (overlapping windows: a zombie is hit once per window it is in)
+        _lanes.queryCells(row, row, col - 2, col + 2, 1.5f, _areaHits);
+    }
+    for (uint32_t z : _areaHits) {
+        damageZombie(z, damage);
+    }
+}
+
+void Simulation::updateCombatLogic() {
+    {
+        PVZ_PROFILE_SCOPE(_profiler, ProfilePhase::COMBAT_HITS);
+        updateBulletHits();
+    }
+    {
+        PVZ_PROFILE_SCOPE(_profiler, ProfilePhase::COMBAT_BITES);
+        updateZombieBites();
+    }
+}
+
+void Simulation::updateBulletHits() {
+    // A. Bullets vs zombies: only the zombies next to the bullet in its own lane
+    for (size_t b = 0; b < _bullets.size(); ++b) {
+        if (!_bullets.active[b]) continue;
+
+        // Box overlap along X; the leftmost zombie is the one the bullet reaches first
+        size_t z = _lanes.findFirstOverlap(_bullets.row[b], _bullets.x[b], _bullets.hitWidth[b] / 2);
+        if (z == LaneIndex::NONE) continue;
+
+        if (_bullets.kind[b] == ProjectileKind::ICE_PEA) {
+            _zombies.speedMultiplier[z] = _bullets.slowEffect[b];
+        }
+        damageZombie(z, _bullets.damage[b]);
+        _bullets.active[b] = 0; // one bullet hits one zombie
+        _events.push(SimEventType::BULLET_REMOVED).bullet = (int)b;
+    }
+}
+
+void Simulation::updateZombieBites() {
+    // B. Zombies eat plants / Boss2 crushes plants
+    for (size_t zi = 0; zi < _zombies.size(); ++zi) {
+        if (_zombies.isDead(zi)) continue;
+
+        int row = _zombies.row[zi];
+        float x = _zombies.x[zi];
+
+        // Boss2 (snow sled) crushes plants directly without stopping
+        if (_zombies.isCrushing[zi]) {
+            float zombieLeft = x - 50;  // approximate sled edges
+            float zombieRight = x + 50;
+
+            for (int col = 0; col < GRID_COLS; col++) {
+                float cellLeft = _geometry.startX + col * _geometry.cellWidth;
+                float cellRight = cellLeft + _geometry.cellWidth;
+                if (!(zombieRight > cellLeft && zombieLeft < cellRight)) continue;
+
+                SimPlant* plant = getTopPlantAt(row, col);
+                if (!plant || plant->isDead()) continue;
+
+                PlantBehaviorKind behavior = plant->data->behavior.kind;
+                if (behavior == PlantBehaviorKind::SPIKES) {
+                    // Spikeweed hurts the sled (2000) and is crushed
+                    SIM_LOG("[Info] Boss2 runs over %s at [%d, %d]!", plant->data->name.c_str(), row, col);
+                    damageZombie(zi, plant->data->behavior.crushDamage);
+                    damagePlant(*plant, INSTANT_KILL_DAMAGE);
+                }
+                else if (behavior == PlantBehaviorKind::MINE) {
+                    SIM_LOG("[Info] Boss2 triggers %s at [%d, %d]!", plant->data->name.c_str(), row, col);
+                    detonateMine(*plant);
+                }
+                else {
+                    SIM_LOG("[Info] Boss2 crushed plant at [%d, %d]!", row, col);
+                    damagePlant(*plant, INSTANT_KILL_DAMAGE);
+                }
+                if (_zombies.isDead(zi)) break;
+            }
+
+            // Ice trail behind Boss2, one per grid cell
+            int currentCol = (int)((x - _geometry.startX) / _geometry.cellWidth);
+            if (currentCol >= 0 && currentCol < GRID_COLS && !(_cells[row][currentCol].terrain & TERRAIN_ICE)) {
+                _cells[row][currentCol].terrain |= TERRAIN_ICE;
+                SimEvent& ice = _events.push(SimEventType::ICE_PLACED);
+                ice.row = row;
+                ice.col = currentCol;
+            }
+            continue;
+        }
+
+        // Normal zombie: look at the cell under its mouth
+        float zombieMouthX = x - 30;
+        int col = (int)((zombieMouthX - _geometry.startX) / _geometry.cellWidth);
+
+        SimPlant* targetPlant = nullptr;
+        if (col >= 0 && col < GRID_COLS && row >= 0 && row < _geometry.rows) {
+            targetPlant = getTopPlantAt(row, col);
+        }
+
+        // Spikeweed cannot be eaten and does not block zombies
+        if (targetPlant && targetPlant->data->behavior.kind == PlantBehaviorKind::SPIKES) {
+            targetPlant = nullptr;
+        }
+
+        // Chomper swallows the zombie whole, then needs 30s to digest
+        if (targetPlant && targetPlant->data->behavior.kind == PlantBehaviorKind::EATER) {
+            SimTick& readyTick = targetPlant->eatReadyTick;
+            if (_ctx.tickCount >= readyTick) {
+                pushPlantAction(*targetPlant, "eat");
+                damageZombie(zi, _zombies.hp[zi] > 0 ? _zombies.hp[zi] : INSTANT_KILL_DAMAGE);
+                readyTick = _ctx.tickCount + secondsToTicks(targetPlant->data->behavior.eatCooldown);
+                SIM_LOG("[Info] %s at [%d, %d] ate a zombie! Starting %.0fs cooldown.", targetPlant->data->name.c_str(),
+                        row, col, targetPlant->data->behavior.eatCooldown);
+                continue;
+            }
+            // Digesting: the zombie bites the Chomper like any other plant
+        }
+
+        if (targetPlant && !targetPlant->isDead()) {
+            setZombieState(zi, ZombieState::ATTACK);
+
+            if (_ctx.tickCount >= _zombies.nextBiteTick[zi]) {
+                // PotatoMine explodes as soon as a zombie bites it
+                if (targetPlant->data->behavior.kind == PlantBehaviorKind::MINE) {
+                    SIM_LOG("[Info] %s at [%d, %d] triggered by zombie eating!", targetPlant->data->name.c_str(), row, col);
+                    detonateMine(*targetPlant);
+                    continue;
+                }
+
+                damagePlant(*targetPlant, _zombies.data[zi]->damage);
+                _zombies.nextBiteTick[zi] = _ctx.tickCount + secondsToTicks(_zombies.data[zi]->attackInterval);
+            }
+
+            if (targetPlant->isDead()) {
+                setZombieState(zi, ZombieState::WALK);
+            }
+        }
+        else if (_zombies.state[zi] == ZombieState::ATTACK) {
+            setZombieState(zi, ZombieState::WALK);
+        }
+    }
+}
+
+void Simulation::detonateMine(SimPlant& mine) {
+    int damage = mine.data->attack > 0 ? mine.data->attack : DEFAULT_EXPLOSION_DAMAGE;
+    explode(mine.data->behavior.aoe, mine.x, mine.y, damage, mine.row, mine.col);
+    removePlant(mine, true);
+}
+
+void Simulation::pushPlantAction(const SimPlant& plant, const char* action) {
+    SimEvent& event = _events.push(SimEventType::PLANT_ACTION);
+    event.plant = plant.handle;
+    event.action = action;
+}
+
+void Simulation::flushEvents() {
+    _events.drain([this](const SimEvent& e) {
+        // Entities are only erased after the batch, so these handles always resolve
+        size_t z = _zombies.indexOf(e.zombie);
+        const SimPlant* plant = getPlant(e.plant);
+        // Every game event is traced here (detail: the zombie / plant involved)
+        PVZ_TRACE_INSTANT(SimEventQueue::getTypeName(e.type), "sim",
+                          z != SimZombieStore::NONE ? _zombies.data[z]->name.c_str() :
+                          plant ? plant->data->name.c_str() : nullptr);
+        switch (e.type) {
+        case SimEventType::ZOMBIE_SPAWNED:
+            if (_callbacks.onZombieSpawned) _callbacks.onZombieSpawned(_zombies.get(z));
+            break;
+        case SimEventType::ZOMBIE_DAMAGED:
+            if (_callbacks.onZombieDamaged) _callbacks.onZombieDamaged(_zombies.get(z), e.amount);
+            break;
+        case SimEventType::ZOMBIE_KILLED:
+            if (_callbacks.onZombieDied) _callbacks.onZombieDied(_zombies.get(z));
+            break;
+        case SimEventType::PLANT_PLACED:
+            if (_callbacks.onPlantPlaced) _callbacks.onPlantPlaced(*plant);
+            break;
+        case SimEventType::PLANT_DAMAGED:
+            if (_callbacks.onPlantDamaged) _callbacks.onPlantDamaged(*plant, e.amount);
+            break;
+        case SimEventType::PLANT_ACTION:
+            if (_callbacks.onPlantAction) _callbacks.onPlantAction(*plant, e.action);
+            break;
+        case SimEventType::PLANT_DESTROYED:
+            if (_callbacks.onPlantRemoved) _callbacks.onPlantRemoved(*plant, e.killed);
+            break;
+        case SimEventType::SHOT_FIRED:
+            if (_callbacks.onBulletFired) _callbacks.onBulletFired(_bullets.get(e.bullet));
+            break;
+        case SimEventType::BULLET_REMOVED:
+            if (_callbacks.onBulletRemoved) _callbacks.onBulletRemoved(_bullets.get(e.bullet));
+            break;
+        case SimEventType::SUN_PRODUCED:
+            // No SimSun when auto-collected (already credited, nothing for the view to show)
+            if (e.sun && _callbacks.onSunSpawned) _callbacks.onSunSpawned(*e.sun);
+            break;
+        case SimEventType::SUN_EXPIRED:
+            if (_callbacks.onSunExpired) _callbacks.onSunExpired(*e.sun);
+            break;
+        case SimEventType::EXPLOSION:
+            if (_callbacks.onExplosion) _callbacks.onExplosion(e.explosion, e.x, e.y);
+            break;
+        case SimEventType::ICE_PLACED:
+            if (_callbacks.onIcePlaced) _callbacks.onIcePlaced(e.row, e.col);
+            break;
+        default:
+            break;
+        }
+    });
+}
+
+void Simulation::removeDeadEntities() {
+    // Swap-and-pop: the last entity fills the hole, so index i is looked at again
+    for (size_t b = 0; b < _bullets.size(); ) {
+        if (_bullets.active[b]) ++b;
+        else _bullets.remove(b);
+    }
+
+    for (size_t z = 0; z < _zombies.size(); ) {
+        if (!_zombies.isDead(z)) {
+            ++z;
+            continue;
+        }
+        // Dead zombies already left their lane; the one moving into the hole keeps its lane slot
+        size_t last = _zombies.size() - 1;
+        if (z != last) _lanes.renumber(last, z);
+        _zombies.remove(z);
+    }
+
+    // Plants keep their order (compacted in place); handles follow them to their new index
+    size_t kept = 0;
+    for (size_t i = 0; i < _plants.size(); ++i) {
+        if (_plants[i]->isDead()) {
+            _plantHandles.destroy(_plants[i]->handle);
+            continue;
+        }
+        if (kept != i) {
+            _plants[kept] = std::move(_plants[i]);
+            _plantHandles.relocate(_plants[kept]->handle, (uint32_t)kept);
+        }
+        ++kept;
+    }
+    _plants.resize(kept);
+
+    _suns.erase(std::remove_if(_suns.begin(), _suns.end(), [](const std::unique_ptr<SimSun>& s) {
+        return !s->active;
+    }), _suns.end());
+}
+
+void Simulation::checkEndConditions() {
+    // Victory: every wave spawned and the lawn is clear
+    if (isAllWavesCompleted() && _zombies.empty()) {
+        _state = GameState::VICTORY;
+        SIM_LOG("[Info] Game ended: Victory");
+        return;
+    }
+
+    // Game over: a zombie reached the house (left edge)
+    for (float x : _zombies.x) {
+        if (x < GRID_START_X - 100) {
+            _state = GameState::GAME_OVER;
+            SIM_LOG("[Info] Game ended: Game Over");
+            return;
+        }
+    }
+}
+
+void Simulation::damageZombie(size_t z, int damage) {
+    if (_zombies.isDead(z)) return;
+
+    _zombies.hp[z] -= damage;
+    SimEvent& hit = _events.push(SimEventType::ZOMBIE_DAMAGED);
+    hit.zombie = _zombies.handle[z];
+    hit.amount = damage;
+
+    if (_zombies.hp[z] <= 0) {
+        setZombieState(z, ZombieState::DIE);
+        _lanes.remove(z);
+        _timers.cancel(_zombies.walk2Timer[z]);
+        _events.push(SimEventType::ZOMBIE_KILLED).zombie = _zombies.handle[z];
+    }
+}
+
+void Simulation::damagePlant(SimPlant& plant, int damage) {
+    if (plant.isDead()) return;
+
+    plant.hp -= damage;
+    SimEvent& bite = _events.push(SimEventType::PLANT_DAMAGED);
+    bite.plant = plant.handle;
+    bite.amount = damage;
+
+    if (plant.hp <= 0) {
+        removePlant(plant, true);
+    }
+}
+
+void Simulation::removePlant(SimPlant& plant, bool killed) {
+    // A LilyPad keeps its cell when only the plant on top of it goes away
+    LawnCell& cell = _cells[plant.row][plant.col];
+    if (cell.base == plant.handle) cell.base = SimHandle();
+    if (cell.top == plant.handle) cell.top = SimHandle();
+    _timers.cancel(plant.skillTimer);
+    if (plant.asleep) {
+        std::vector<SimHandle>& sleepers = _sleepingPlants[plant.row];
+        sleepers.erase(std::find(sleepers.begin(), sleepers.end(), plant.handle));
+        plant.asleep = false;
+    }
+
+    // Erased from _plants in removeDeadEntities (we may be iterating it right now)
+    plant.hp = 0;
+    SimEvent& removed = _events.push(SimEventType::PLANT_DESTROYED);
+    removed.plant = plant.handle;
+    removed.killed = killed;
+}
+
+SimPlant* Simulation::getTopPlantAt(int row, int col) {
+    const LawnCell& cell = _cells[row][col];
+    SimPlant* top = getPlant(cell.top);
+    return top ? top : getPlant(cell.base);
+}
+
+SimPlant* Simulation::getPlant(SimHandle handle) const {
+    uint32_t index = _plantHandles.lookup(handle);
+    return index != HandleTable::NONE ? _plants[index].get() : nullptr;
+}
+
+const SimPlant* Simulation::getPlantAt(int row, int col) const {
+    if (row < 0 || row >= _geometry.rows || col < 0 || col >= GRID_COLS) return nullptr;
+    return getPlant(_cells[row][col].base);
+}
+
+unsigned char Simulation::getTerrain(int row, int col) const {
+    if (row < 0 || row >= _geometry.rows || col < 0 || col >= GRID_COLS) return 0;
+    return _cells[row][col].terrain;
+}
+
+bool Simulation::isWaterRow(int row) const {
+    return (getTerrain(row, GRID_COLS - 1) & TERRAIN_WATER) != 0;
+}
+
+float Simulation::getCooldownRemaining(int plantId) const {
+    auto it = _ctx.cardCooldowns.find(plantId);
+    if (it == _ctx.cardCooldowns.end() || it->second.first <= _ctx.tickCount) return 0.0f;
+    return (it->second.first - _ctx.tickCount) * SIM_TICK_SECONDS;
+}
+
+float Simulation::getCooldownTotal(int plantId) const {
+    auto it = _ctx.cardCooldowns.find(plantId);
+    return it != _ctx.cardCooldowns.end() ? it->second.second : 0.0f;
+}
+
+bool Simulation::tryPlantAt(int plantId, int row, int col) {
+    if (row < 0 || row >= _geometry.rows || col < 0 || col >= GRID_COLS) {
+        return false;
+    }
+
+    // 0. Only cards from the loadout, and not while cooling down
+    auto cardIt = _ctx.cardCooldowns.find(plantId);
+    if (cardIt == _ctx.cardCooldowns.end()) {
+        SIM_LOG("[Info] Plant %d is not in the loadout", plantId);
+        return false;
+    }
+    if (!_freePlanting && cardIt->second.first > _ctx.tickCount) {
+        SIM_LOG("[Info] Plant %d is in cooldown, cannot plant", plantId);
+        return false;
+    }
+
+    const PlantData* def = _data->findPlant(plantId);
+    if (!def) {
+        SIM_LOG("[Err] Planting failed: Plant ID not found: %d", plantId);
+        return false;
+    }
+    const PlantData& plantData = *def;
+
+    // 1. Pool rows need a LilyPad first; everything else needs an empty cell
+    LawnCell& cell = _cells[row][col];
+    bool water = (cell.terrain & TERRAIN_WATER) != 0;
+    bool isLilyPad = (plantData.behavior.kind == PlantBehaviorKind::PLATFORM);
+    SimPlant* existingPlant = getPlant(cell.base);
+    if (water && !isLilyPad) {
+        if (existingPlant == nullptr) {
+            SIM_LOG("[Info] Cannot plant %s at water row [%d, %d]: need LilyPad first!", plantData.name.c_str(), row, col);
+            return false;
+        }
+        if (existingPlant->data->behavior.kind != PlantBehaviorKind::PLATFORM || cell.top.isSet()) {
+            SIM_LOG("[Info] Cannot plant %s at water row [%d, %d]: LilyPad is occupied!", plantData.name.c_str(), row, col);
+            return false;
+        }
+    }
+    else if (existingPlant != nullptr) {
+        SIM_LOG("[Info] Grid [%d, %d] is already occupied!", row, col);
+        return false;
+    }
+
+    // 2. Enough sun?
+    if (!_freePlanting && _ctx.sun < plantData.cost) {
+        SIM_LOG("[Info] Not enough sun! Have: %d, Need: %d", _ctx.sun, plantData.cost);
+        return false;
+    }
+
+    // 3. Create the plant
+    std::unique_ptr<SimPlant> plant(new SimPlant());
+    plant->id = _ctx.nextId++;
+    plant->handle = _plantHandles.create((uint32_t)_plants.size());
+    plant->typeId = plantId;
+    plant->data = def;
+    plant->row = row;
+    plant->col = col;
+    plant->x = _geometry.cellCenterX(col);
+    plant->y = _geometry.cellCenterY(row);
+    plant->hp = plantData.hp;
+    plant->onLilyPad = water && !isLilyPad;
+
+    // The LilyPad stays the base layer; the plant on top goes to the top layer
+    (plant->onLilyPad ? cell.top : cell.base) = plant->handle;
+
+    _plants.push_back(std::move(plant));
+    SimPlant& planted = *_plants.back();
+
+    if (!_freePlanting) {
+        _ctx.sun -= plantData.cost;
+        float cooldownTime = calculateCooldownByCost(plantData.cost);
+        cardIt->second = std::make_pair(_ctx.tickCount + secondsToTicks(cooldownTime), cooldownTime);
+    }
+
+    _events.push(SimEventType::PLANT_PLACED).plant = planted.handle;
+    SIM_LOG("[Info] Successfully planted %s at [%d, %d]. Sun left: %d", plantData.name.c_str(), row, col, _ctx.sun);
+
+    // 4. Attack / production interval (only behaviors with a skill); CherryBomb explodes right after being planted
+    if (plantData.attackSpeed > 0 && SKILL_HANDLERS[(int)plantData.behavior.kind]) {
+        SimTimer skill;
+        skill.kind = SimTimer::Kind::PLANT_SKILL;
+        skill.plant = planted.handle;
+        planted.skillTimer = scheduleIn(plantData.attackSpeed, skill);
+    }
+    if (plantData.behavior.kind == PlantBehaviorKind::BOMB) {
+        SimTimer fuse;
+        fuse.kind = SimTimer::Kind::BOMB_FUSE;
+        fuse.plant = planted.handle;
+        fuse.aoe = plantData.behavior.aoe;
+        fuse.row = row;
+        fuse.col = col;
+        fuse.x = planted.x;
+        fuse.y = planted.y;
+        fuse.damage = plantData.attack > 0 ? plantData.attack : DEFAULT_EXPLOSION_DAMAGE;
+        scheduleIn(plantData.behavior.fuse, fuse);
+    }
+
+    // Player commands run between ticks: deliver their events right away
+    flushEvents();
+    return true;
+}
+
+bool Simulation::tryDigAt(int row, int col) {
+    if (row < 0 || row >= _geometry.rows || col < 0 || col >= GRID_COLS) {
+        SIM_LOG("[Warn] Invalid grid position [%d, %d]", row, col);
+        return false;
+    }
+
+    // The plant on top of a LilyPad is dug first, the LilyPad itself next time
+    SimPlant* plant = getTopPlantAt(row, col);
+    if (plant == nullptr) {
+        SIM_LOG("[Info] No plant at [%d, %d] to dig", row, col);
+        return false;
+    }
+
+    removePlant(*plant, false);
+    flushEvents();
+    SIM_LOG("[Info] Successfully dug plant at [%d, %d]", row, col);
+    return true;
+}
+
+bool Simulation::collectSun(SimId sunId) {
+    for (auto it = _suns.begin(); it != _suns.end(); ++it) {
+        if ((*it)->id == sunId) {
+            _ctx.sun += (*it)->value;
+            _timers.cancel((*it)->expiryTimer);
+            _suns.erase(it);
+            return true;
+        }
+    }
+    return false;
+}
+
+float Simulation::calculateCooldownByCost(int cost) const {
+    if (_minCost >= _maxCost) {
+        return 7.5f;
+    }
+
+    // Linear: cheapest card 5s, most expensive 10s
+    float ratio = static_cast<float>(cost - _minCost) / static_cast<float>(_maxCost - _minCost);
+    float cooldown = 5.0f + ratio * 5.0f;
+    if (cooldown < 5.0f) cooldown = 5.0f;
+    if (cooldown > 10.0f) cooldown = 10.0f;
+    return cooldown;
+}
@@ -0,0 +1,235 @@
+// Headless gameplay simulation: level timeline, plants, zombies, bullets, suns and combat
+// Pulled out of GameScene so a level can run without a window; GameScene mirrors it into sprites
+// 2026.10.17 by BillyDu
+// Each Simulation owns all of its game state (SimContext + entities) and only reads the shared
+// SimDataSnapshot, so several lawns can run side by side, also on different threads
+#ifndef __SIMULATION_H__
+#define __SIMULATION_H__
+
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "EntityStore.h"
+#include "FrameProfiler.h"
+#include "LaneIndex.h"
+#include "SimContext.h"
+#include "SimEvents.h"
+#include "SimDataSnapshot.h"
+#include "SimTypes.h"
+
+// Everything a Simulation needs to start a level (filled by GameScene or a headless runner)
+struct SimSetup {
+    int mapId = 1;
+    LawnGeometry geometry;
+    LawnTerrain terrain;                         // water cells etc. (level file "terrain")
+    SimDataPtr data;                             // plant / zombie definitions, shared read-only
+    std::vector<SpawnEvent> waves;
+    std::vector<int> loadout;                    // selected seed cards
+    int initialSun = 500;
+    unsigned int seed = 0;                       // sky sun positions
+    bool autoCollectSun = false;                 // headless: credit suns as soon as they appear
+    bool freePlanting = false;                   // benchmarks: no sun cost, no seed card cooldown
+};
+
+// Notifications for the view layer (sounds, sprites, animations); all optional
+// Called from the event batch at the end of each tick (and of each player command), never while
+// the simulation is iterating its entities
+struct SimCallbacks {
+    std::function<void(const SimZombie&)> onZombieSpawned;
+    std::function<void(const SimZombie&, int)> onZombieDamaged;      // zombie, damage
+    std::function<void(const SimZombie&)> onZombieDied;
+    std::function<void(const SimPlant&)> onPlantPlaced;
+    std::function<void(const SimPlant&, int)> onPlantDamaged;        // plant, damage
+    std::function<void(const SimPlant&, const char*)> onPlantAction; // plant, animation name
+    std::function<void(const SimPlant&, bool)> onPlantRemoved;       // plant, killed (false = dug / used up)
+    std::function<void(const SimBullet&)> onBulletFired;
+    std::function<void(const SimBullet&)> onBulletRemoved;
+    std::function<void(const SimSun&)> onSunSpawned;
+    std::function<void(const SimSun&)> onSunExpired;
+    std::function<void(ExplosionKind, float, float)> onExplosion;    // kind, x, y
+    std::function<void(int, int)> onIcePlaced;                       // row, col
+};
+
+class Simulation {
+public:
+    explicit Simulation(const SimSetup& setup);
+
+    // Start over with a new setup, as if freshly constructed (callbacks and profiler stay attached);
+    // entity arrays, timer nodes and scratch buffers keep their capacity, so a batch worker can
+    // play game after game on one Simulation without reallocating
+    void reset(const SimSetup& setup);
+
+    void setCallbacks(const SimCallbacks& callbacks) { _callbacks = callbacks; }
+    // Optional per-phase timers (nullptr = off)
+    void setProfiler(FrameProfiler* profiler) { _profiler = profiler; }
+
+    // Advance the simulation by one step of dt seconds (does nothing once the game has ended)
+    // Every caller steps by SIM_TICK_SECONDS; timers and cooldowns count whole ticks
+    void tick(float dt);
+
+    // --- Player commands ---
+    // Plant the given card at (row, col); false when the cell, sun or cooldown forbids it
+    bool tryPlantAt(int plantId, int row, int col);
+    // Dig up the top plant at (row, col)
+    bool tryDigAt(int row, int col);
+    // Collect a sun lying on the lawn
+    bool collectSun(SimId sunId);
+
+    // --- Queries ---
+    GameState getState() const { return _state; }
+    float getTime() const { return _ctx.time; }
+    // Ticks simulated so far (fast-forward / headless throughput)
+    SimTick getTickCount() const { return _ctx.tickCount; }
+    int getSun() const { return _ctx.sun; }
+    int getMapId() const { return _mapId; }
+    const LawnGeometry& getGeometry() const { return _geometry; }
+    // TERRAIN_* bits of a cell (0 outside the lawn)
+    unsigned char getTerrain(int row, int col) const;
+    // Zombies entering this row swim (its rightmost cell is water)
+    bool isWaterRow(int row) const;
+    bool isAllWavesCompleted() const { return _ctx.nextWave >= _ctx.waves.size(); }
+    // Game events of one type since the level started
+    unsigned long long getEventTotal(SimEventType type) const { return _events.getTotal(type); }
+
+    // Base plant of the cell (the LilyPad for stacked cells), nullptr if empty
+    const SimPlant* getPlantAt(int row, int col) const;
+    // Remaining / total seed card cooldown for a plant ID (0 when ready)
+    float getCooldownRemaining(int plantId) const;
+    float getCooldownTotal(int plantId) const;
+
+    // Zombies and bullets are struct-of-arrays stores (index order changes when entities are removed)
+    const SimZombieStore& getZombies() const { return _zombies; }
+    const std::vector<std::unique_ptr<SimPlant>>& getPlants() const { return _plants; }
+    const SimBulletStore& getBullets() const { return _bullets; }
+    const std::vector<std::unique_ptr<SimSun>>& getSuns() const { return _suns; }
+
+private:
+    // Timer wheel payload. Plants and zombies are referenced by handle (a stale one is ignored);
+    // the sun pointer stays valid because removing a sun cancels its timer first
+    struct SimTimer {
+        enum class Kind {
+            PLANT_SKILL,     // attack / production interval elapsed
+            VOLLEY_SHOT,     // later projectiles of a volley (Repeater's second pea)
+            BOMB_FUSE,       // CherryBomb fuse
+            SUN_EXPIRY,      // uncollected sun fades out
+            SKY_SUN,         // next sun from the sky (recurring)
+            ZOMBIE_WALK2     // walk1 -> walk2 animation
+        };
+        Kind kind = Kind::SKY_SUN;
+        SimHandle plant;             // skill owner, or the CherryBomb (it may be dug up during the fuse)
+        SimSun* sun = nullptr;
+        SimHandle zombie;
+        ProjectileKind projectile = ProjectileKind::PEA;
+        ExplosionKind aoe = ExplosionKind::CHERRY_BOMB;
+        int row = 0;
+        int col = 0;
+        float x = 0.0f;
+        float y = 0.0f;
+        int damage = 0;
+    };
+
+    // Zombie definition for this level: map difficulty multipliers applied once, shared by every spawn
+    struct ZombieArchetype {
+        ZombieData data;
+        bool isBoss1 = false;
+        bool isCrushing = false;
+    };
+    void buildZombieArchetypes();
+
+    // Tick phases (same order as the old GameScene::update)
+    void updateWaves();
+    void updateZombies(float dt);
+    void updateTimers();
+    void onTimer(const SimTimer& timer);
+    void updateBullets(float dt);
+    void updateCombatLogic();   // A then B below
+    void updateBulletHits();    // A. bullets vs zombies
+    void updateZombieBites();   // B. zombies eat / crush plants
+    void removeDeadEntities();
+    void checkEndConditions();
+
+    void spawnZombie(int id, int row);
+    void checkPhaseTransition(size_t zombie);
+    // State and walk speed change together: the advance kernel only reads walkSpeed
+    void setZombieState(size_t zombie, ZombieState state);
+    // Plant skills dispatch on PlantBehaviorKind through SKILL_HANDLERS (no name / ID compares)
+    using SkillHandler = void (Simulation::*)(SimPlant&);
+    static const SkillHandler SKILL_HANDLERS[];
+    void triggerSkill(SimPlant& plant);
+    void shooterSkill(SimPlant& plant);
+    void producerSkill(SimPlant& plant);
+    void spikesSkill(SimPlant& plant);
+    // Blast of a PotatoMine-like plant (bitten or run over); removes the plant
+    void detonateMine(SimPlant& mine);
+    // Shooters need a zombie ahead, Spikeweed a zombie in the lane; everything else always works
+    bool hasSkillTarget(const SimPlant& plant) const;
+    void sleepPlant(SimPlant& plant);
+    // A zombie entered the row: re-arm its sleeping plants on their old rhythm
+    void wakeLane(int row);
+    void fireProjectile(ProjectileKind kind, int row, float x, float y, int damage);
+    void spawnSun(float startX, float startY, float x, float y, bool fromSky);
+    void pushPlantAction(const SimPlant& plant, const char* action);
+    // Hand the pending events to _callbacks (one batch)
+    void flushEvents();
+    // Deadline `seconds` from the current tick
+    TimerHandle scheduleIn(float seconds, const SimTimer& timer);
+    void explode(ExplosionKind kind, float x, float y, int damage, int row, int col);
+
+    void damageZombie(size_t zombie, int damage);
+    void damagePlant(SimPlant& plant, int damage);
+    void removePlant(SimPlant& plant, bool killed);
+
+    // Zombie-facing plant in a cell: the plant on top of a LilyPad, otherwise the base plant
+    SimPlant* getTopPlantAt(int row, int col);
+    // Live plant behind a handle in O(1), nullptr once it is gone
+    SimPlant* getPlant(SimHandle handle) const;
+    bool hasZombieAhead(int row, float x) const;
+    float calculateCooldownByCost(int cost) const;
+
+    int _mapId;
+    LawnGeometry _geometry;
+    SimDataPtr _data;
+    // Per-level zombie archetypes (SimZombie::data points in here; never modified after construction)
+    std::unordered_map<int, ZombieArchetype> _zombieArchetypes;
+    SimCallbacks _callbacks;
+    FrameProfiler* _profiler = nullptr;
+
+    // Timeline, RNG, clocks, sun and cooldowns of this game
+    SimContext _ctx;
+
+    // Moving entities: dense component arrays, swap-and-pop in removeDeadEntities
+    // Plants and suns stay individual records (few, stationary, referenced by the grid and timers)
+    SimZombieStore _zombies;
+    LaneIndex _lanes;  // live zombies per row, sorted by X (bullet collision); reads _zombies
+    std::vector<std::unique_ptr<SimPlant>> _plants;
+    HandleTable _plantHandles;  // plant handle -> index in _plants
+    SimBulletStore _bullets;
+    std::vector<uint32_t> _culledBullets;  // updateBullets scratch (bullets past the screen edge)
+    std::vector<uint32_t> _areaHits;       // LaneIndex area query scratch (explosions, Spikeweed)
+    std::vector<std::unique_ptr<SimSun>> _suns;
+    TimerWheel<SimTimer> _timers;
+    SimEventQueue _events;
+
+    // Sleeping plants per row (see SimPlant::asleep)
+    std::vector<SimHandle> _sleepingPlants[MAX_GRID_ROWS];
+
+    // One lawn cell: plant layers and terrain, every lookup is an array read
+    struct LawnCell {
+        SimHandle base;               // plant in the ground (the LilyPad on water)
+        SimHandle top;                // plant standing on the LilyPad
+        unsigned char terrain = 0;    // TERRAIN_* bits
+    };
+    LawnCell _cells[MAX_GRID_ROWS][GRID_COLS];
+
+    // Cost range of the loadout (seed card cooldown formula)
+    int _minCost = 0;
+    int _maxCost = 0;
+
+    GameState _state = GameState::PLAYING;
+    bool _autoCollectSun = false;
+    bool _freePlanting = false;
+};
+
+#endif // __SIMULATION_H__
@@ -0,0 +1,195 @@
+// Hierarchical timer wheel for the simulation: deadlines are whole ticks, only due timers are touched
+// 4 levels x 64 slots cover 2^24 ticks (~77 hours at 60 Hz); anything later waits in an overflow list
+// Same-tick timers fire in a fixed order (no pointers or hashing involved), so runs stay deterministic
+// 2026.10.17 by BillyDu
+#ifndef __TIMER_WHEEL_H__
+#define __TIMER_WHEEL_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Cancellation handle; a default handle (or one whose timer already fired) is simply ignored
+struct TimerHandle {
+    uint32_t index = 0;
+    uint32_t generation = 0;   // 0 = no timer
+
+    bool isValid() const { return generation != 0; }
+};
+
+template <typename T>
+class TimerWheel {
+public:
+    using Tick = uint64_t;
+
+    explicit TimerWheel(Tick now = 0) : _now(now) {}
+
+    Tick now() const { return _now; }
+    size_t size() const { return _count; }
+
+    // Drop every timer and rewind the clock; node storage keeps its capacity for the next game
+    void clear(Tick now = 0) {
+        _nodes.clear();
+        _freeHead = NONE;
+        for (auto& list : _lists) list = List();
+        _count = 0;
+        _now = now;
+    }
+
+    // Deadlines at or before now() fire on the next tick
+    TimerHandle schedule(Tick deadline, const T& payload) {
+        uint32_t index = allocate();
+        Node& node = _nodes[index];
+        node.deadline = deadline > _now ? deadline : _now + 1;
+        node.payload = payload;
+        insert(index);
+        ++_count;
+
+        TimerHandle handle;
+        handle.index = index;
+        handle.generation = node.generation;
+        return handle;
+    }
+
+    // Clears the handle; false when the timer already fired or was cancelled
+    bool cancel(TimerHandle& handle) {
+        TimerHandle h = handle;
+        handle = TimerHandle();
+        if (!h.isValid() || h.index >= _nodes.size()) return false;
+        Node& node = _nodes[h.index];
+        if (node.owner == FREE || node.generation != h.generation) return false;
+
+        unlink(node.owner, h.index);
+        release(h.index);
+        --_count;
+        return true;
+    }
+
+    // Move the clock to `now`, calling fire(payload) for every timer that comes due on the way;
+    // fire may schedule or cancel timers (new ones never fire before the next tick)
+    template <typename Fn>
+    void advance(Tick now, Fn&& fire) {
+        while (_now < now) {
+            ++_now;
+            // Each level's next slot is redistributed downwards as its window starts
+            for (int level = 1; level < LEVELS; ++level) {
+                if ((_now & ((Tick(1) << (SLOT_BITS * level)) - 1)) != 0) break;
+                cascade(slotList(level, _now));
+                if (level == LEVELS - 1) cascade(OVERFLOW);
+            }
+
+            uint32_t due = slotList(0, _now);
+            while (_lists[due].head != NONE) {
+                uint32_t index = _lists[due].head;
+                unlink(due, index);
+                T payload = _nodes[index].payload;
+                release(index);
+                --_count;
+                fire(payload);
+            }
+        }
+    }
+
+private:
+    static const int SLOT_BITS = 6;
+    static const int SLOTS = 1 << SLOT_BITS;
+    static const Tick SLOT_MASK = SLOTS - 1;
+    static const int LEVELS = 4;
+    static const uint32_t NONE = 0xFFFFFFFFu;
+    // Lists are addressed by index (level * SLOTS + slot, then the overflow list), so the wheel
+    // stays valid when its owner is moved
+    static const uint32_t OVERFLOW = LEVELS * SLOTS;
+    static const uint32_t FREE = NONE;
+
+    // Intrusive doubly linked list of node indices (FIFO: same-tick timers keep their order)
+    struct List {
+        uint32_t head = NONE;
+        uint32_t tail = NONE;
+    };
+
+    struct Node {
+        Tick deadline = 0;
+        T payload = T();
+        uint32_t prev = NONE;
+        uint32_t next = NONE;        // also links the free list
+        uint32_t generation = 1;
+        uint32_t owner = FREE;       // list index
+    };
+
+    uint32_t allocate() {
+        if (_freeHead != NONE) {
+            uint32_t index = _freeHead;
+            _freeHead = _nodes[index].next;
+            return index;
+        }
+        _nodes.push_back(Node());
+        return (uint32_t)(_nodes.size() - 1);
+    }
+
+    void release(uint32_t index) {
+        Node& node = _nodes[index];
+        node.owner = FREE;
+        node.payload = T();
+        if (++node.generation == 0) node.generation = 1;
+        node.next = _freeHead;
+        _freeHead = index;
+    }
+
+    // Level by distance from now, slot by the deadline's own bits at that level
+    void insert(uint32_t index) {
+        Node& node = _nodes[index];
+        Tick delta = node.deadline - _now;
+        uint32_t list = OVERFLOW;
+        for (int level = 0; level < LEVELS; ++level) {
+            if (delta < (Tick(1) << (SLOT_BITS * (level + 1)))) {
+                list = slotList(level, node.deadline);
+                break;
+            }
+        }
+        pushBack(list, index);
+    }
+
+    static uint32_t slotList(int level, Tick tick) {
+        return (uint32_t)(level * SLOTS + ((tick >> (SLOT_BITS * level)) & SLOT_MASK));
+    }
+
+    void cascade(uint32_t list) {
+        List pending = _lists[list];
+        _lists[list] = List();
+        for (uint32_t index = pending.head; index != NONE; ) {
+            uint32_t next = _nodes[index].next;
+            insert(index);
+            index = next;
+        }
+    }
+
+    void pushBack(uint32_t listIndex, uint32_t index) {
+        List& list = _lists[listIndex];
+        Node& node = _nodes[index];
+        node.owner = listIndex;
+        node.prev = list.tail;
+        node.next = NONE;
+        if (list.tail != NONE) _nodes[list.tail].next = index;
+        else list.head = index;
+        list.tail = index;
+    }
+
+    void unlink(uint32_t listIndex, uint32_t index) {
+        List& list = _lists[listIndex];
+        Node& node = _nodes[index];
+        if (node.prev != NONE) _nodes[node.prev].next = node.next;
+        else list.head = node.next;
+        if (node.next != NONE) _nodes[node.next].prev = node.prev;
+        else list.tail = node.prev;
+        node.prev = node.next = NONE;
+        node.owner = FREE;
+    }
+
+    Tick _now;
+    size_t _count = 0;
+    std::vector<Node> _nodes;
+    uint32_t _freeHead = NONE;
+    List _lists[LEVELS * SLOTS + 1];
+};
+
+#endif // __TIMER_WHEEL_H__
@@ -0,0 +1,187 @@
+// TraceWriter implementation
+// 2026.10.17 by BillyDu
+#include "TraceWriter.h"
+
+#include <cstdlib>
+#include <cstring>
+
+std::atomic<bool> TraceWriter::s_active{ false };
+
+namespace {
+    const std::chrono::steady_clock::time_point s_clockOrigin = std::chrono::steady_clock::now();
+    const int FLUSH_INTERVAL_MS = 50;
+
+    thread_local void* t_buffer = nullptr;
+
+    void copyTruncated(char* dst, size_t size, const char* src) {
+        if (!src) {
+            dst[0] = '\0';
+            return;
+        }
+        strncpy(dst, src, size - 1);
+        dst[size - 1] = '\0';
+    }
+
+    // JSON string body (names are identifiers / resource paths, escape just in case)
+    void writeEscaped(FILE* file, const char* s) {
+        for (; *s; ++s) {
+            if (*s == '"' || *s == '\\') fputc('\\', file);
+            if ((unsigned char)*s >= 0x20) fputc(*s, file);
+        }
+    }
+}
+
+TraceWriter& TraceWriter::getInstance() {
+    static TraceWriter instance;
+    return instance;
+}
+
+TraceWriter::~TraceWriter() {
+    stop();
+}
+
+uint64_t TraceWriter::nowMicros() {
+    return (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - s_clockOrigin).count();
+}
+
+bool TraceWriter::start(const std::string& path) {
+    if (_file) return false;
+
+    _file = fopen(path.c_str(), "w");
+    if (!_file) {
+        fprintf(stderr, "[Err] Trace file cannot be opened: %s\n", path.c_str());
+        return false;
+    }
+    fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n", _file);
+    _firstEvent = true;
+    _dropped = 0;
+    _stopRequested = false;
+
+    s_active.store(true, std::memory_order_release);
+    _flushThread = std::thread(&TraceWriter::flushLoop, this);
+    fprintf(stderr, "[Info] Tracing to %s\n", path.c_str());
+    return true;
+}
+
+bool TraceWriter::startFromEnvironment() {
+    const char* path = getenv("PVZ_TRACE");
+    if (!path || !*path || _file) return false;
+    return start(path);
+}
+
+void TraceWriter::stop() {
+    if (!_file) return;
+
+    s_active.store(false, std::memory_order_release);
+    {
+        std::lock_guard<std::mutex> lock(_wakeMutex);
+        _stopRequested = true;
+    }
+    _wake.notify_one();
+    if (_flushThread.joinable()) {
+        _flushThread.join();
+    }
+    drain();
+
+    fputs("\n]}\n", _file);
+    fclose(_file);
+    _file = nullptr;
+    if (_dropped > 0) {
+        fprintf(stderr, "[Warn] Trace dropped %llu events (ring buffer full)\n", (unsigned long long)_dropped.load());
+    }
+}
+
+TraceWriter::ThreadBuffer* TraceWriter::getThreadBuffer() {
+    if (!t_buffer) {
+        // First event on this thread: register a ring (kept until exit, the flush thread may still read it)
+        std::unique_ptr<ThreadBuffer> buffer(new ThreadBuffer());
+        std::lock_guard<std::mutex> lock(_buffersMutex);
+        buffer->threadId = _nextThreadId++;
+        t_buffer = buffer.get();
+        _buffers.push_back(std::move(buffer));
+    }
+    return static_cast<ThreadBuffer*>(t_buffer);
+}
+
+void TraceWriter::push(const Event& event) {
+    ThreadBuffer* buffer = getThreadBuffer();
+    size_t head = buffer->head.load(std::memory_order_relaxed);
+    size_t tail = buffer->tail.load(std::memory_order_acquire);
+    if (head - tail >= ThreadBuffer::CAPACITY) {
+        _dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    buffer->events[head & (ThreadBuffer::CAPACITY - 1)] = event;
+    buffer->head.store(head + 1, std::memory_order_release);
+}
+
+void TraceWriter::recordComplete(const char* name, const char* category, uint64_t startUs, uint64_t durationUs,
+                                 const char* detail) {
+    if (!isActive()) return;
+    Event event;
+    copyTruncated(event.name, sizeof(event.name), name);
+    copyTruncated(event.detail, sizeof(event.detail), detail);
+    event.category = category;
+    event.phase = 'X';
+    event.timestamp = startUs;
+    event.duration = durationUs;
+    push(event);
+}
+
+void TraceWriter::recordInstant(const char* name, const char* category, const char* detail) {
+    if (!isActive()) return;
+    Event event;
+    copyTruncated(event.name, sizeof(event.name), name);
+    copyTruncated(event.detail, sizeof(event.detail), detail);
+    event.category = category;
+    event.phase = 'i';
+    event.timestamp = nowMicros();
+    event.duration = 0;
+    push(event);
+}
+
+void TraceWriter::flushLoop() {
+    std::unique_lock<std::mutex> lock(_wakeMutex);
+    while (!_stopRequested) {
+        _wake.wait_for(lock, std::chrono::milliseconds(FLUSH_INTERVAL_MS));
+        lock.unlock();
+        drain();
+        lock.lock();
+    }
+}
+
+void TraceWriter::drain() {
+    std::lock_guard<std::mutex> lock(_buffersMutex);
+    for (auto& buffer : _buffers) {
+        size_t tail = buffer->tail.load(std::memory_order_relaxed);
+        size_t head = buffer->head.load(std::memory_order_acquire);
+        for (; tail != head; ++tail) {
+            writeEvent(buffer->events[tail & (ThreadBuffer::CAPACITY - 1)], buffer->threadId);
+        }
+        buffer->tail.store(tail, std::memory_order_release);
+    }
+    fflush(_file);
+}
+
+void TraceWriter::writeEvent(const Event& event, unsigned int threadId) {
+    if (!_firstEvent) fputs(",\n", _file);
+    _firstEvent = false;
+
+    fputs("{\"name\":\"", _file);
+    writeEscaped(_file, event.name);
+    fprintf(_file, "\",\"cat\":\"%s\",\"ph\":\"%c\",\"pid\":1,\"tid\":%u,\"ts\":%llu",
+            event.category ? event.category : "", event.phase, threadId, (unsigned long long)event.timestamp);
+    if (event.phase == 'X') {
+        fprintf(_file, ",\"dur\":%llu", (unsigned long long)event.duration);
+    }
+    else {
+        fputs(",\"s\":\"t\"", _file);
+    }
+    if (event.detail[0]) {
+        fputs(",\"args\":{\"detail\":\"", _file);
+        writeEscaped(_file, event.detail);
+        fputs("\"}", _file);
+    }
+    fputc('}', _file);
+}
@@ -0,0 +1,124 @@
+// Chrome trace-event (Perfetto / chrome://tracing) writer for frame timelines
+// Each thread records into its own lock-free ring buffer; a background thread drains them to JSON
+// Off by default: PVZ_TRACE=<file> (environment) or `--trace <file>` on Linux
+// 2026.10.17 by BillyDu
+#ifndef __TRACE_WRITER_H__
+#define __TRACE_WRITER_H__
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+class TraceWriter {
+public:
+    static TraceWriter& getInstance();
+
+    TraceWriter(const TraceWriter&) = delete;
+    void operator=(const TraceWriter&) = delete;
+
+    // Open the file and start the flush thread; false if already running or the file cannot be opened
+    bool start(const std::string& path);
+    // Start when PVZ_TRACE is set (no-op otherwise or when already running)
+    bool startFromEnvironment();
+    // Drain everything, close the JSON array and the file
+    void stop();
+
+    // Cheap check for call sites (one relaxed load)
+    static bool isActive() { return s_active.load(std::memory_order_relaxed); }
+
+    // Microseconds on the trace clock (steady, since process start)
+    static uint64_t nowMicros();
+
+    // "X" event: a scope that started at startUs and lasted durationUs
+    void recordComplete(const char* name, const char* category, uint64_t startUs, uint64_t durationUs,
+                        const char* detail = nullptr);
+    // "i" event: a point in time (spawn, explosion, texture ready)
+    void recordInstant(const char* name, const char* category, const char* detail = nullptr);
+
+    // Events lost because a ring was full when the flush thread fell behind
+    uint64_t getDroppedCount() const { return _dropped.load(std::memory_order_relaxed); }
+
+private:
+    struct Event {
+        char name[48];
+        char detail[80];        // optional "args": {"detail": ...}
+        const char* category;   // string literal
+        char phase;             // 'X' or 'i'
+        uint64_t timestamp;
+        uint64_t duration;
+    };
+
+    // Single producer (owning thread) / single consumer (flush thread)
+    struct ThreadBuffer {
+        static const size_t CAPACITY = 8192; // power of two
+        Event events[CAPACITY];
+        std::atomic<size_t> head{ 0 };       // written by the producer
+        std::atomic<size_t> tail{ 0 };       // written by the consumer
+        unsigned int threadId = 0;
+    };
+
+    TraceWriter() = default;
+    ~TraceWriter();
+
+    ThreadBuffer* getThreadBuffer();
+    void push(const Event& event);
+    void flushLoop();
+    void drain();
+    void writeEvent(const Event& event, unsigned int threadId);
+
+    static std::atomic<bool> s_active;
+
+    std::mutex _buffersMutex;                            // guards _buffers (registration / draining)
+    std::vector<std::unique_ptr<ThreadBuffer>> _buffers;
+    unsigned int _nextThreadId = 1;
+
+    FILE* _file = nullptr;
+    bool _firstEvent = true;
+    std::thread _flushThread;
+    std::mutex _wakeMutex;
+    std::condition_variable _wake;
+    bool _stopRequested = false;
+    std::atomic<uint64_t> _dropped{ 0 };
+};
+
+// RAII scope recorded as a complete event while tracing is on; otherwise one branch
+class TraceScope {
+public:
+    TraceScope(const char* name, const char* category, const char* detail = nullptr)
+        : _name(name), _category(category), _detail(detail), _active(TraceWriter::isActive()),
+          _start(_active ? TraceWriter::nowMicros() : 0) {
+    }
+
+    ~TraceScope() {
+        if (_active) {
+            TraceWriter::getInstance().recordComplete(_name, _category, _start, TraceWriter::nowMicros() - _start, _detail);
+        }
+    }
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+    const char* _name;
+    const char* _category;
+    const char* _detail;
+    bool _active;
+    uint64_t _start;
+};
+
+#define PVZ_TRACE_CONCAT_INNER(a, b) a##b
+#define PVZ_TRACE_CONCAT(a, b) PVZ_TRACE_CONCAT_INNER(a, b)
+// Trace the rest of the enclosing block; detail (optional) must outlive the scope
+#define PVZ_TRACE_SCOPE(name, category, ...) \
+    TraceScope PVZ_TRACE_CONCAT(_traceScope, __LINE__)((name), (category), ##__VA_ARGS__)
+#define PVZ_TRACE_INSTANT(name, category, ...) \
+    do { if (TraceWriter::isActive()) TraceWriter::getInstance().recordInstant((name), (category), ##__VA_ARGS__); } while (0)
+
+#endif // __TRACE_WRITER_H__
@@ -0,0 +1,91 @@
+// 帧耗时分析浮层实现
+// 2026.10.17 by BillyDu
+#include "ProfilerOverlay.h"
+#include "../Sim/Simulation.h"
+#include "../Utils/AnimationHelper.h"
+
+USING_NS_CC;
+
+namespace {
+    const float REFRESH_INTERVAL = 0.25f;
+    const float PADDING = 6.0f;
+}
+
+ProfilerOverlay* ProfilerOverlay::create(FrameProfiler* profiler, const Simulation* sim) {
+    ProfilerOverlay* ret = new (std::nothrow) ProfilerOverlay();
+    if (ret && ret->init(profiler, sim)) {
+        ret->autorelease();
+        return ret;
+    }
+    delete ret;
+    return nullptr;
+}
+
+bool ProfilerOverlay::init(FrameProfiler* profiler, const Simulation* sim) {
+    if (!Node::init()) return false;
+    _profiler = profiler;
+    _sim = sim;
+
+    _background = LayerColor::create(Color4B(0, 0, 0, 160));
+    this->addChild(_background, 0);
+
+    _label = Label::createWithTTF("", "fonts/arial.ttf", 14);
+    _label->setAnchorPoint(Vec2::ZERO);
+    _label->setPosition(PADDING, PADDING);
+    _label->setAlignment(TextHAlignment::LEFT);
+    this->addChild(_label, 1);
+
+    this->setVisible(false);
+    return true;
+}
+
+void ProfilerOverlay::toggle() {
+    _shown = !_shown;
+    _profiler->setEnabled(_shown);
+    this->setVisible(_shown);
+
+    if (_shown) {
+        _lastTickCount = _sim->getTickCount();
+        refresh(0.0f);
+        this->schedule(CC_SCHEDULE_SELECTOR(ProfilerOverlay::refresh), REFRESH_INTERVAL);
+    }
+    else {
+        this->unschedule(CC_SCHEDULE_SELECTOR(ProfilerOverlay::refresh));
+    }
+}
+
+void ProfilerOverlay::refresh(float dt) {
+    std::string text;
+    char line[96];
+
+    snprintf(line, sizeof(line), "%-12s %8s %8s\n", "phase (us)", "p50", "p99");
+    text += line;
+    for (int i = 0; i < FrameProfiler::PHASE_COUNT; ++i) {
+        auto phase = static_cast<ProfilePhase>(i);
+        snprintf(line, sizeof(line), "%-12s %8.1f %8.1f\n", FrameProfiler::getPhaseName(phase),
+                 _profiler->getPercentile(phase, 50.0), _profiler->getPercentile(phase, 99.0));
+        text += line;
+    }
+
+    snprintf(line, sizeof(line), "zombies %zu  plants %zu  bullets %zu  suns %zu  (%d frames)",
+             _sim->getZombies().size(), _sim->getPlants().size(),
+             _sim->getBullets().size(), _sim->getSuns().size(), _profiler->getFrameCount());
+    text += line;
+
+    snprintf(line, sizeof(line), "\nanim cache hits %d  misses %d",
+             AnimationHelper::getCacheHits(), AnimationHelper::getCacheMisses());
+    text += line;
+
+    // 快进时可以看出引擎实际能跑多少步/秒
+    unsigned long long ticks = _sim->getTickCount();
+    if (dt > 0.0f) {
+        snprintf(line, sizeof(line), "\nsim %.0f ticks/s", (ticks - _lastTickCount) / dt);
+        text += line;
+    }
+    _lastTickCount = ticks;
+
+    _label->setString(text);
+    Size size = _label->getContentSize();
+    _background->setContentSize(Size(size.width + PADDING * 2, size.height + PADDING * 2));
+    this->setContentSize(_background->getContentSize());
+}
@@ -0,0 +1,35 @@
+// 帧耗时分析浮层：显示 GameScene::update 各阶段的 p50 / p99（微秒）、实体数量和实际模拟步频
+// 放在左下角 FPS 统计（setDisplayStats）上方，F3 切换；隐藏时不计时、不刷新文字
+// 2026.10.17 by BillyDu
+#ifndef __PROFILER_OVERLAY_H__
+#define __PROFILER_OVERLAY_H__
+
+#include "cocos2d.h"
+#include "../Sim/FrameProfiler.h"
+
+class Simulation;
+
+class ProfilerOverlay : public cocos2d::Node {
+public:
+    // profiler / sim 由 GameScene 持有，生命周期长于浮层
+    static ProfilerOverlay* create(FrameProfiler* profiler, const Simulation* sim);
+
+    // 显示 / 隐藏（同时开关 profiler 的计时）
+    void toggle();
+    bool isShown() const { return _shown; }
+
+private:
+    bool init(FrameProfiler* profiler, const Simulation* sim);
+
+    // 文字刷新频率远低于帧率，格式化字符串的开销可以忽略
+    void refresh(float dt);
+
+    FrameProfiler* _profiler = nullptr;
+    const Simulation* _sim = nullptr;
+    cocos2d::LayerColor* _background = nullptr;
+    cocos2d::Label* _label = nullptr;
+    bool _shown = false;
+    unsigned long long _lastTickCount = 0;  // 上次刷新时的模拟步数，用于计算 ticks/s
+};
+
+#endif // __PROFILER_OVERLAY_H__
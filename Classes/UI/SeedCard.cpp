@@ -193,25 +193,16 @@ void SeedCard::setOnSelectCallback(const std::function<void(int)>& callback) {
     _onSelectCallback = callback;
 }
 
-void SeedCard::startCooldown(float cooldownTime) {
-    _cooldownTotal = cooldownTime;
-    _cooldownRemaining = cooldownTime;
-    _cooldownLabel->setVisible(true);
-    updateCooldown(0.0f); // ��������һ����ʾ
-}
+void SeedCard::updateCooldown(float remaining) {
+    _cooldownRemaining = remaining;
 
-void SeedCard::updateCooldown(float dt) {
-    if (_cooldownRemaining > 0.0f) {
-        _cooldownRemaining -= dt;
-        
-        if (_cooldownRemaining <= 0.0f) {
-            _cooldownRemaining = 0.0f;
-            _cooldownLabel->setVisible(false);
-        } else {
-            // ��ʾ����ʱ������ȡ����
-            int seconds = static_cast<int>(std::ceil(_cooldownRemaining));
-            _cooldownLabel->setString(std::to_string(seconds));
-            _cooldownLabel->setVisible(true);
-        }
+    if (_cooldownRemaining <= 0.0f) {
+        _cooldownRemaining = 0.0f;
+        _cooldownLabel->setVisible(false);
+    } else {
+        // ��ʾ����ʱ������ȡ����
+        int seconds = static_cast<int>(std::ceil(_cooldownRemaining));
+        _cooldownLabel->setString(std::to_string(seconds));
+        _cooldownLabel->setVisible(true);
     }
 }
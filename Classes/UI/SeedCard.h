@@ -19,11 +19,8 @@ public:
     // 更新阳光是否足够 (用于改变卡片颜色/禁用状态)
     void updateSunCheck(int currentSun);
     
-    // ������ȴ״̬
-    void updateCooldown(float dt);
-    
-    // �����ȴ
-    void startCooldown(float cooldownTime);
+    // Show the cooldown countdown (remaining seconds, owned by the Simulation)
+    void updateCooldown(float remaining);
     
     // ����Ƿ�����ȴ��
     bool isInCooldown() const { return _cooldownRemaining > 0.0f; }
@@ -38,7 +35,6 @@ private:
     
     // ��ȴ���
     float _cooldownRemaining = 0.0f;  // ʣ����ȴʱ��
-    float _cooldownTotal = 0.0f;      // ����ȴʱ��
     
     // UI ���
     cocos2d::Sprite* _bg = nullptr;        // 卡片背景PNG素材，
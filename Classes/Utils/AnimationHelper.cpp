@@ -1,11 +1,48 @@
 // 实现动画辅助工具类
 // 2025.12.2 by BillyDu
+// 2026.10.17 by BillyDu: 动画缓存
+// 2026.10.17 by BillyDu: 图集子帧
 #include "AnimationHelper.h"
 #include "cocos2d.h"
+#include "../Sim/TraceWriter.h"
 
 USING_NS_CC;
 
+int AnimationHelper::s_cacheHits = 0;
+int AnimationHelper::s_cacheMisses = 0;
+
+std::string AnimationHelper::makeCacheKey(const AnimationConfig& config) {
+    char suffix[64];
+    snprintf(suffix, sizeof(suffix), "|%d|%.4f", config.frameCount, config.frameDelay);
+    return config.frameFormat + suffix;
+}
+
 Animation* AnimationHelper::createAnimationFromConfig(const AnimationConfig& config) {
+    if (!config.cacheKey.empty()) {
+        return findOrBuild(config, config.cacheKey);
+    }
+    // 临时拼出的配置（没经过 DataManager）才在这里现算键
+    return findOrBuild(config, makeCacheKey(config));
+}
+
+Animation* AnimationHelper::findOrBuild(const AnimationConfig& config, const std::string& key) {
+    Animation* animation = AnimationCache::getInstance()->getAnimation(key);
+    if (animation) {
+        ++s_cacheHits;
+        return animation;
+    }
+
+    ++s_cacheMisses;
+    animation = buildAnimation(config);
+    if (animation) {
+        AnimationCache::getInstance()->addAnimation(animation, key);
+        CCLOG("[Info] Animation cached: %s (hits: %d, misses: %d)", key.c_str(), s_cacheHits, s_cacheMisses);
+    }
+    return animation;
+}
+
+Animation* AnimationHelper::buildAnimation(const AnimationConfig& config) {
+    PVZ_TRACE_SCOPE("AnimationHelper::buildAnimation", "assets", config.frameFormat.c_str());
     if (config.frameFormat.empty() || config.frameCount <= 0) {
         CCLOG("[Err] Invalid animation config: frameFormat=%s, frameCount=%d", 
               config.frameFormat.c_str(), config.frameCount);
@@ -21,15 +58,18 @@ Animation* AnimationHelper::createAnimationFromConfig(const AnimationConfig& con
         char framePath[256];
         snprintf(framePath, sizeof(framePath), config.frameFormat.c_str(), i);
         
-        // 尝试从 SpriteFrameCache 获取，如果不存在则创建
+        // 尝试从 SpriteFrameCache 获取（图集帧由 DataManager::loadAtlases 预先载入），如果不存在则创建
         SpriteFrame* frame = SpriteFrameCache::getInstance()->getSpriteFrameByName(framePath);
         if (!frame) {
             // 如果缓存中没有，直接从文件加载
+            PVZ_TRACE_INSTANT("texture load (sync)", "assets", framePath);
             Texture2D* texture = Director::getInstance()->getTextureCache()->addImage(framePath);
             if (texture) {
                 Rect rect = Rect::ZERO;
                 rect.size = texture->getContentSize();
                 frame = SpriteFrame::createWithTexture(texture, rect);
+                // 放入 SpriteFrameCache，之后按帧路径查找即可命中
+                SpriteFrameCache::getInstance()->addSpriteFrame(frame, framePath);
                 CCLOG("[Debug] Loaded frame %d: %s (size: %.0f x %.0f)", 
                       i, framePath, rect.size.width, rect.size.height);
             } else {
@@ -56,6 +96,20 @@ Animation* AnimationHelper::createAnimationFromConfig(const AnimationConfig& con
     return animation;
 }
 
+void AnimationHelper::setFirstFrame(Sprite* sprite, const AnimationConfig& config, const std::string& framePath) {
+    if (!sprite || framePath.empty()) {
+        return;
+    }
+    if (config.inAtlas) {
+        SpriteFrame* frame = SpriteFrameCache::getInstance()->getSpriteFrameByName(framePath);
+        if (frame) {
+            sprite->setSpriteFrame(frame);
+            return;
+        }
+    }
+    sprite->setTexture(framePath);
+}
+
 Action* AnimationHelper::createAnimateFromConfig(const AnimationConfig& config) {
     Animation* animation = createAnimationFromConfig(config);
     if (!animation) {
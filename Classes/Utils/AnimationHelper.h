@@ -1,9 +1,13 @@
 // 动画辅助工具类
 // 用于从动画配置创建 Cocos2d-x Animation 对象
 // 2025.12.2 by BillyDu
+// 2026.10.17 by BillyDu: 构建好的 Animation 按 (帧格式, 帧数, 帧间隔) 缓存，重复播放只做一次查表
+// 2026.10.17 by BillyDu: 图集帧（pack_atlases 生成）优先于散图
 #ifndef __ANIMATION_HELPER_H__
 #define __ANIMATION_HELPER_H__
 
+#include <string>
+
 #include "cocos2d.h"
 #include "../Entities/GameDataStructures.h"
 
@@ -11,7 +15,7 @@ USING_NS_CC;
 
 class AnimationHelper {
 public:
-    // 从动画配置创建 Animation 对象
+    // 从动画配置获取 Animation 对象（首次构建后存入 AnimationCache，之后直接命中）
     static Animation* createAnimationFromConfig(const AnimationConfig& config);
     
     // 从动画配置创建并运行动画（返回 Action 对象，可能是 Animate 或 RepeatForever）
@@ -19,6 +23,24 @@ public:
     
     // 从动画配置创建有限时间的动画动作（用于序列化，不包含 RepeatForever）
     static FiniteTimeAction* createFiniteAnimateFromConfig(const AnimationConfig& config);
+
+    // 设置动画开始前的首帧：图集动画用图集子帧（不换纹理），否则按路径加载散图
+    static void setFirstFrame(Sprite* sprite, const AnimationConfig& config, const std::string& framePath);
+
+    // 缓存统计（命中 / 未命中次数），显示在 F3 性能面板
+    static int getCacheHits() { return s_cacheHits; }
+    static int getCacheMisses() { return s_cacheMisses; }
+
+    // 缓存键：帧格式 + 帧数 + 帧间隔（循环次数不影响 Animation 本身）
+    // 由 DataManager 在加载时写入 AnimationConfig::cacheKey，播放时不再拼字符串
+    static std::string makeCacheKey(const AnimationConfig& config);
+
+private:
+    static Animation* findOrBuild(const AnimationConfig& config, const std::string& key);
+    static Animation* buildAnimation(const AnimationConfig& config);
+
+    static int s_cacheHits;
+    static int s_cacheMisses;
 };
 
 #endif // __ANIMATION_HELPER_H__
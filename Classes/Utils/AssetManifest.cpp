@@ -0,0 +1,105 @@
+// 实现关卡资源清单
+// 2026.10.17 by BillyDu
+#include "AssetManifest.h"
+#include "cocos2d.h"
+#include "../Managers/DataManager.h"
+
+USING_NS_CC;
+
+AssetManifest AssetManifest::buildForLevel(const std::vector<int>& plantIds, const std::vector<SpawnEvent>& waves,
+                                           const LawnTerrain& terrain) {
+    AssetManifest manifest;
+
+    for (int plantId : plantIds) {
+        manifest.addPlant(plantId);
+    }
+
+    // 刷在水路的僵尸换成鸭子僵尸（规则与 Simulation::spawnZombie 共用 swimmingZombieId）
+    std::unordered_set<int> zombieIds;
+    for (const auto& wave : waves) {
+        zombieIds.insert(terrain.isWaterRow(wave.row) ? swimmingZombieId(wave.zombieId) : wave.zombieId);
+    }
+    for (int zombieId : zombieIds) {
+        manifest.addZombie(zombieId);
+    }
+
+    // 子弹与爆炸（帧数由文件决定，与 GameScene::createExplosionAnimation 相同的上限）
+    manifest.addTexture("bullets/pea.png");
+    manifest.addTexture("bullets/PeaIce/PeaIce_0.png");
+    manifest.addFrameSequence("bullets/BulletMushRoom/%d.png", 30);
+    manifest.addFrameSequence("bullets/boom1/%d.png", 30);
+    manifest.addFrameSequence("bullets/boom2/%d.png", 30);
+    manifest.addTexture("general/sun.png");
+
+    CCLOG("[Info] Asset manifest: %zu textures, %zu animations",
+          manifest._textures.size(), manifest._animations.size());
+    return manifest;
+}
+
+void AssetManifest::addTexture(const std::string& path) {
+    if (path.empty() || !_textureSet.insert(path).second) {
+        return;
+    }
+    _textures.push_back(path);
+}
+
+void AssetManifest::addAnimation(const AnimationConfig& config) {
+    char suffix[32];
+    snprintf(suffix, sizeof(suffix), "|%d", config.frameCount);
+    if (!_animationSet.insert(config.frameFormat + suffix).second) {
+        return;
+    }
+    _animations.push_back(config);
+
+    // 图集动画的纹理已由 DataManager::loadAtlases 载入
+    if (config.inAtlas) {
+        return;
+    }
+    char framePath[256];
+    for (int i = 1; i <= config.frameCount; ++i) {
+        snprintf(framePath, sizeof(framePath), config.frameFormat.c_str(), i);
+        addTexture(framePath);
+    }
+}
+
+void AssetManifest::addPlant(int plantId) {
+    try {
+        const PlantData& data = DataManager::getInstance().getPlantData(plantId);
+        addTexture(data.texturePath);
+        for (const auto& anim : data.animations) {
+            addAnimation(anim.second);
+        }
+    }
+    catch (const std::exception& e) {
+        CCLOG("[Warn] Asset manifest skips plant %d: %s", plantId, e.what());
+    }
+}
+
+void AssetManifest::addZombie(int zombieId) {
+    try {
+        const ZombieData& data = DataManager::getInstance().getZombieData(zombieId);
+        addTexture(data.texturePath);
+        for (const auto& anim : data.animations) {
+            addAnimation(anim.second);
+        }
+    }
+    catch (const std::exception& e) {
+        CCLOG("[Warn] Asset manifest skips zombie %d: %s", zombieId, e.what());
+    }
+}
+
+void AssetManifest::addFrameSequence(const std::string& frameFormat, int maxFrames) {
+    auto fileUtils = FileUtils::getInstance();
+    char framePath[256];
+    for (int i = 1; i <= maxFrames; ++i) {
+        snprintf(framePath, sizeof(framePath), frameFormat.c_str(), i);
+        if (!fileUtils->isFileExist(framePath)) {
+            break;
+        }
+        // 图集里已有的帧不必再读散图
+        if (SpriteFrameCache::getInstance()->getSpriteFrameByName(framePath)) {
+            continue;
+        }
+        addTexture(framePath);
+    }
+}
@@ -0,0 +1,42 @@
+// 关卡资源清单：根据选中的植物和关卡刷新表收集所有会用到的纹理与动画
+// LoadingScene 用它异步预加载，首次出现某种僵尸 / 植物时不再同步读图
+// 2026.10.17 by BillyDu
+#ifndef __ASSET_MANIFEST_H__
+#define __ASSET_MANIFEST_H__
+
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "../Entities/GameDataStructures.h"
+#include "../Sim/SimTypes.h" // LawnTerrain
+
+class AssetManifest {
+public:
+    // 收集一关的资源：选中植物 + 刷新表中的僵尸（刷在水路的换成鸭子僵尸，水路来自关卡的 terrain）+ 子弹 / 爆炸帧
+    // 需要 DataManager 已加载数据（图集中的帧已常驻内存，不再列入纹理）
+    static AssetManifest buildForLevel(const std::vector<int>& plantIds, const std::vector<SpawnEvent>& waves,
+                                       const LawnTerrain& terrain);
+
+    // 待异步加载的图片路径（去重，保持加入顺序）
+    const std::vector<std::string>& getTextures() const { return _textures; }
+
+    // 纹理就绪后在主线程预先构建的动画
+    const std::vector<AnimationConfig>& getAnimations() const { return _animations; }
+
+    void addTexture(const std::string& path);
+    void addAnimation(const AnimationConfig& config);
+
+private:
+    void addPlant(int plantId);
+    void addZombie(int zombieId);
+    // 帧数未知的序列（爆炸），按文件是否存在逐帧收集
+    void addFrameSequence(const std::string& frameFormat, int maxFrames);
+
+    std::vector<std::string> _textures;
+    std::unordered_set<std::string> _textureSet;
+    std::vector<AnimationConfig> _animations;
+    std::unordered_set<std::string> _animationSet;
+};
+
+#endif // __ASSET_MANIFEST_H__
@@ -0,0 +1,79 @@
+// 实体对象池：复用子弹、阳光、僵尸和特效节点，战斗中不再反复创建/释放 cocos 节点
+// T 需要提供 static T* create() 和 void reset()
+// 2026.10.17 by BillyDu
+#ifndef __ENTITY_POOL_H__
+#define __ENTITY_POOL_H__
+
+#include "cocos2d.h"
+
+template <typename T>
+class EntityPool {
+public:
+    // 预先创建到 count 个对象（关卡开始时调用，数量来自关卡配置）
+    void prewarm(int count) {
+        while (static_cast<int>(_free.size() + _active.size()) < count) {
+            T* obj = T::create();
+            if (!obj) break;
+            ++_createdCount;
+            _free.pushBack(obj);
+        }
+    }
+
+    // 取出一个已重置、未挂到任何父节点上的对象；池空时才新建
+    T* acquire() {
+        T* obj = nullptr;
+        if (!_free.empty()) {
+            obj = _free.back();
+            _active.pushBack(obj);
+            _free.popBack();
+        }
+        else {
+            obj = T::create();
+            if (!obj) return nullptr;
+            ++_createdCount;
+            _active.pushBack(obj);
+            CCLOG("[Warn] EntityPool grew to %d objects", _createdCount);
+        }
+        obj->reset();
+        return obj;
+    }
+
+    // 从场景移除并放回池中
+    void recycle(T* obj) {
+        ssize_t index = _active.getIndex(obj);
+        if (index < 0) return;
+
+        obj->removeFromParent();
+        release(index);
+    }
+
+    // 回收已经自行移除的对象（死亡动画结束、RemoveSelf 等），每帧调用一次
+    void reclaimDetached() {
+        for (ssize_t i = _active.size() - 1; i >= 0; --i) {
+            if (_active.at(i)->getParent() == nullptr) {
+                release(i);
+            }
+        }
+    }
+
+    int getActiveCount() const { return static_cast<int>(_active.size()); }
+    int getFreeCount() const { return static_cast<int>(_free.size()); }
+    int getCreatedCount() const { return _createdCount; }
+
+private:
+    // 交换到末尾后弹出，避免 O(n) 的 erase；先放入 _free 保证引用计数不归零
+    void release(ssize_t index) {
+        _free.pushBack(_active.at(index));
+        ssize_t last = _active.size() - 1;
+        if (index != last) {
+            _active.swap(index, last);
+        }
+        _active.popBack();
+    }
+
+    cocos2d::Vector<T*> _free;    // 空闲对象
+    cocos2d::Vector<T*> _active;  // 已取出（在场景中或正在播放移除动画）
+    int _createdCount = 0;
+};
+
+#endif // __ENTITY_POOL_H__
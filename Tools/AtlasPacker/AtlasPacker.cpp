@@ -0,0 +1,382 @@
+// AtlasPacker implementation
+// 2026.10.17 by BillyDu
+#include "AtlasPacker.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sys/stat.h>
+
+#ifdef _WIN32
+#include <direct.h>
+#include <io.h>
+#else
+#include <dirent.h>
+#endif
+
+namespace {
+    // Sub-directories and files of a directory (names only, unsorted)
+    void listDirectory(const std::string& path, std::vector<std::string>& dirs, std::vector<std::string>& files) {
+#ifdef _WIN32
+        _finddata_t info;
+        intptr_t handle = _findfirst((path + "/*").c_str(), &info);
+        if (handle == -1) return;
+        do {
+            std::string name = info.name;
+            if (name == "." || name == "..") continue;
+            if (info.attrib & _A_SUBDIR) dirs.push_back(name);
+            else files.push_back(name);
+        } while (_findnext(handle, &info) == 0);
+        _findclose(handle);
+#else
+        DIR* dir = opendir(path.c_str());
+        if (!dir) return;
+        while (dirent* entry = readdir(dir)) {
+            std::string name = entry->d_name;
+            if (name == "." || name == "..") continue;
+            struct stat st;
+            if (stat((path + "/" + name).c_str(), &st) != 0) continue;
+            if (S_ISDIR(st.st_mode)) dirs.push_back(name);
+            else files.push_back(name);
+        }
+        closedir(dir);
+#endif
+    }
+
+    bool makeDirectory(const std::string& path) {
+#ifdef _WIN32
+        return _mkdir(path.c_str()) == 0 || errno == EEXIST;
+#else
+        return mkdir(path.c_str(), 0755) == 0 || errno == EEXIST;
+#endif
+    }
+
+    size_t fileSize(const std::string& path) {
+        struct stat st;
+        return stat(path.c_str(), &st) == 0 ? (size_t)st.st_size : 0;
+    }
+
+    bool endsWith(const std::string& s, const std::string& suffix) {
+        return s.size() >= suffix.size() && s.compare(s.size() - suffix.size(), suffix.size(), suffix) == 0;
+    }
+
+    // "12.png" -> 12, anything else -> 0
+    int frameNumber(const std::string& file) {
+        if (!endsWith(file, ".png") || file.size() == 4) return 0;
+        for (size_t i = 0; i + 4 < file.size(); ++i) {
+            if (file[i] < '0' || file[i] > '9') return 0;
+        }
+        return atoi(file.c_str());
+    }
+
+    int nextPowerOfTwo(int v) {
+        int p = 1;
+        while (p < v) p <<= 1;
+        return p;
+    }
+}
+
+AtlasPacker::AtlasPacker(const PackOptions& options)
+    : _options(options) {
+}
+
+bool AtlasPacker::run(std::string& error) {
+    _stats = PackStats();
+    _groups.clear();
+    _plists.clear();
+
+    // Group = category + entity, e.g. "plants/peashooter_shoot" and "plants/peashooter" -> plants_peashooter,
+    // "zombies/normalzombie/*" -> zombies_normalzombie
+    for (const auto& category : _options.categories) {
+        std::vector<std::string> dirs, files;
+        listDirectory(_options.resourceRoot + "/" + category, dirs, files);
+        std::sort(dirs.begin(), dirs.end());
+        for (const auto& dir : dirs) {
+            std::string entity = dir.substr(0, dir.find('_'));
+            scanDirectory(category + "_" + entity, category + "/" + dir);
+        }
+    }
+    if (_groups.empty()) {
+        error = "no frame sequences found under " + _options.resourceRoot;
+        return false;
+    }
+    _stats.groups = (int)_groups.size();
+
+    if (!_options.dryRun && !makeDirectory(_options.resourceRoot + "/" + _options.outputDir)) {
+        error = "cannot create " + _options.outputDir;
+        return false;
+    }
+
+    for (const auto& group : _groups) {
+        if (!packGroup(group.first, group.second, error)) {
+            return false;
+        }
+    }
+
+    return _options.dryRun || writeManifest(error);
+}
+
+void AtlasPacker::scanDirectory(const std::string& group, const std::string& relativeDir) {
+    std::vector<std::string> dirs, files;
+    listDirectory(_options.resourceRoot + "/" + relativeDir, dirs, files);
+
+    // Numbered frames form a sequence; other PNGs (cards, static textures) stay loose
+    std::vector<std::pair<int, std::string>> numbered;
+    for (const auto& file : files) {
+        int number = frameNumber(file);
+        if (number > 0) {
+            numbered.push_back(std::make_pair(number, file));
+        }
+        else if (endsWith(file, ".gif")) {
+            ++_stats.skippedFiles;
+        }
+    }
+    if (!numbered.empty()) {
+        std::sort(numbered.begin(), numbered.end());
+        auto& names = _groups[group];
+        for (const auto& frame : numbered) {
+            names.push_back(relativeDir + "/" + frame.second);
+        }
+        ++_stats.sequences;
+    }
+
+    std::sort(dirs.begin(), dirs.end());
+    for (const auto& dir : dirs) {
+        scanDirectory(group, relativeDir + "/" + dir);
+    }
+}
+
+void AtlasPacker::trim(const RgbaImage& source, Frame& frame) {
+    int minX = source.width, minY = source.height, maxX = -1, maxY = -1;
+    for (int y = 0; y < source.height; ++y) {
+        for (int x = 0; x < source.width; ++x) {
+            if (source.alphaAt(x, y) != 0) {
+                minX = std::min(minX, x);
+                maxX = std::max(maxX, x);
+                minY = std::min(minY, y);
+                maxY = std::max(maxY, y);
+            }
+        }
+    }
+    if (maxX < 0) {
+        // Fully transparent frame: keep one pixel so the frame still exists
+        minX = minY = maxX = maxY = 0;
+    }
+
+    frame.sourceWidth = source.width;
+    frame.sourceHeight = source.height;
+    frame.trimX = minX;
+    frame.trimY = minY;
+    frame.pixels.width = maxX - minX + 1;
+    frame.pixels.height = maxY - minY + 1;
+    frame.pixels.pixels.resize((size_t)frame.pixels.width * frame.pixels.height * 4);
+    for (int y = 0; y < frame.pixels.height; ++y) {
+        memcpy(&frame.pixels.pixels[(size_t)y * frame.pixels.width * 4],
+               &source.pixels[((size_t)(minY + y) * source.width + minX) * 4],
+               (size_t)frame.pixels.width * 4);
+    }
+}
+
+size_t AtlasPacker::placeShelves(std::vector<Frame*>& frames, size_t first, int width, int height) const {
+    int pad = _options.padding;
+    int x = pad, y = pad, shelfHeight = 0;
+    size_t i = first;
+    for (; i < frames.size(); ++i) {
+        Frame* frame = frames[i];
+        int w = frame->pixels.width;
+        int h = frame->pixels.height;
+        if (x + w + pad > width) {
+            // Next shelf
+            x = pad;
+            y += shelfHeight + pad;
+            shelfHeight = 0;
+        }
+        if (x + w + pad > width || y + h + pad > height) {
+            break;
+        }
+        frame->pageX = x;
+        frame->pageY = y;
+        x += w + pad;
+        shelfHeight = std::max(shelfHeight, h);
+    }
+    return i - first;
+}
+
+bool AtlasPacker::packGroup(const std::string& group, const std::vector<std::string>& frameNames, std::string& error) {
+    std::vector<Frame> frames;
+    frames.reserve(frameNames.size());
+    for (const auto& name : frameNames) {
+        std::string path = _options.resourceRoot + "/" + name;
+        RgbaImage image;
+        std::string decodeError;
+        if (!loadPng(path, image, decodeError)) {
+            // Leave it loose; AnimationHelper falls back to the file
+            fprintf(stderr, "[Warn] %s: %s, left unpacked\n", name.c_str(), decodeError.c_str());
+            ++_stats.skippedFiles;
+            continue;
+        }
+        ++_stats.looseTextures;
+        _stats.looseGpuBytes += (size_t)image.width * image.height * 4;
+        _stats.looseFileBytes += fileSize(path);
+
+        Frame frame;
+        frame.name = name;
+        trim(image, frame);
+        frames.push_back(std::move(frame));
+    }
+    if (frames.empty()) {
+        return true;
+    }
+
+    // Tallest first keeps shelves tight
+    std::vector<Frame*> order;
+    for (auto& frame : frames) order.push_back(&frame);
+    std::stable_sort(order.begin(), order.end(), [](const Frame* a, const Frame* b) {
+        return a->pixels.height > b->pixels.height;
+    });
+
+    // Candidate page sizes, smallest area first (square or 2:1)
+    std::vector<std::pair<int, int>> sizes;
+    for (int w = 64; w <= _options.maxPageSize; w <<= 1) {
+        sizes.push_back(std::make_pair(w, w / 2));
+        sizes.push_back(std::make_pair(w, w));
+    }
+
+    std::vector<Page> pages;
+    size_t first = 0;
+    while (first < order.size()) {
+        Page page;
+        size_t remaining = order.size() - first;
+        for (const auto& size : sizes) {
+            if (placeShelves(order, first, size.first, size.second) == remaining) {
+                page.width = size.first;
+                page.height = size.second;
+                break;
+            }
+        }
+        size_t placed = remaining;
+        if (page.width == 0) {
+            // Does not fit on one page: fill a full-size page and carry the rest over
+            page.width = page.height = _options.maxPageSize;
+            placed = placeShelves(order, first, page.width, page.height);
+            if (placed == 0) {
+                error = order[first]->name + " is larger than the maximum page size";
+                return false;
+            }
+        }
+        else {
+            // Re-run on the chosen size (the last failed attempt overwrote the positions)
+            placeShelves(order, first, page.width, page.height);
+        }
+        page.frames.assign(order.begin() + first, order.begin() + first + placed);
+        pages.push_back(page);
+        first += placed;
+    }
+
+    for (size_t i = 0; i < pages.size(); ++i) {
+        std::string baseName = pages.size() == 1 ? group : group + "_" + std::to_string(i);
+        if (!writePage(baseName, pages[i], error)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool AtlasPacker::writePage(const std::string& baseName, const Page& page, std::string& error) {
+    ++_stats.pages;
+    _stats.atlasGpuBytes += (size_t)nextPowerOfTwo(page.width) * nextPowerOfTwo(page.height) * 4;
+    if (_options.dryRun) {
+        return true;
+    }
+
+    RgbaImage atlas;
+    atlas.width = page.width;
+    atlas.height = page.height;
+    atlas.pixels.assign((size_t)page.width * page.height * 4, 0);
+    for (const Frame* frame : page.frames) {
+        for (int y = 0; y < frame->pixels.height; ++y) {
+            memcpy(&atlas.pixels[((size_t)(frame->pageY + y) * page.width + frame->pageX) * 4],
+                   &frame->pixels.pixels[(size_t)y * frame->pixels.width * 4],
+                   (size_t)frame->pixels.width * 4);
+        }
+    }
+
+    std::string relativeBase = _options.outputDir + "/" + baseName;
+    std::string pngPath = _options.resourceRoot + "/" + relativeBase + ".png";
+    std::string plistPath = _options.resourceRoot + "/" + relativeBase + ".plist";
+    if (!savePng(pngPath, atlas, error)) {
+        error = pngPath + ": " + error;
+        return false;
+    }
+
+    std::ofstream plist(plistPath.c_str());
+    if (!plist) {
+        error = "cannot write " + plistPath;
+        return false;
+    }
+    plist << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+          << "<!DOCTYPE plist PUBLIC \"-//Apple//DTD PLIST 1.0//EN\" \"http://www.apple.com/DTDs/PropertyList-1.0.dtd\">\n"
+          << "<plist version=\"1.0\">\n<dict>\n    <key>frames</key>\n    <dict>\n";
+    for (const Frame* frame : page.frames) {
+        int w = frame->pixels.width;
+        int h = frame->pixels.height;
+        // cocos2d offset: trimmed rect center relative to the source center, Y up
+        float offsetX = frame->trimX + w * 0.5f - frame->sourceWidth * 0.5f;
+        float offsetY = frame->sourceHeight * 0.5f - (frame->trimY + h * 0.5f);
+        char buffer[512];
+        snprintf(buffer, sizeof(buffer),
+                 "        <key>%s</key>\n"
+                 "        <dict>\n"
+                 "            <key>frame</key>\n            <string>{{%d,%d},{%d,%d}}</string>\n"
+                 "            <key>offset</key>\n            <string>{%g,%g}</string>\n"
+                 "            <key>rotated</key>\n            <false/>\n"
+                 "            <key>sourceColorRect</key>\n            <string>{{%d,%d},{%d,%d}}</string>\n"
+                 "            <key>sourceSize</key>\n            <string>{%d,%d}</string>\n"
+                 "        </dict>\n",
+                 frame->name.c_str(), frame->pageX, frame->pageY, w, h, offsetX, offsetY,
+                 frame->trimX, frame->trimY, w, h, frame->sourceWidth, frame->sourceHeight);
+        plist << buffer;
+    }
+    plist << "    </dict>\n    <key>metadata</key>\n    <dict>\n"
+          << "        <key>format</key>\n        <integer>2</integer>\n"
+          << "        <key>realTextureFileName</key>\n        <string>" << baseName << ".png</string>\n"
+          << "        <key>size</key>\n        <string>{" << page.width << "," << page.height << "}</string>\n"
+          << "        <key>textureFileName</key>\n        <string>" << baseName << ".png</string>\n"
+          << "    </dict>\n</dict>\n</plist>\n";
+    plist.close();
+
+    _stats.atlasFileBytes += fileSize(pngPath) + fileSize(plistPath);
+    _plists.push_back(relativeBase + ".plist");
+    return true;
+}
+
+bool AtlasPacker::writeManifest(std::string& error) {
+    std::string path = _options.resourceRoot + "/" + _options.manifest;
+    std::ofstream out(path.c_str());
+    if (!out) {
+        error = "cannot write " + path;
+        return false;
+    }
+    out << "{\n    \"atlases\": [\n";
+    for (size_t i = 0; i < _plists.size(); ++i) {
+        out << "        \"" << _plists[i] << "\"" << (i + 1 < _plists.size() ? "," : "") << "\n";
+    }
+    out << "    ]\n}\n";
+    return true;
+}
+
+void AtlasPacker::printReport(FILE* out) const {
+    // One sprite of every sequence on screen: loose frames break the batch on every texture switch,
+    // atlas frames only when the page changes
+    fprintf(out, "Atlas packing report\n");
+    fprintf(out, "  groups: %d, sequences: %d, skipped files: %d\n", _stats.groups, _stats.sequences, _stats.skippedFiles);
+    fprintf(out, "  %-22s %12s %12s\n", "", "before", "after");
+    fprintf(out, "  %-22s %12d %12d\n", "textures", _stats.looseTextures, _stats.pages);
+    fprintf(out, "  %-22s %12d %12d\n", "draw calls (estimate)", _stats.sequences, _stats.pages);
+    fprintf(out, "  %-22s %12zu %12zu\n", "GPU bytes (RGBA8888)", _stats.looseGpuBytes, _stats.atlasGpuBytes);
+    if (!_options.dryRun) {
+        fprintf(out, "  %-22s %12zu %12zu\n", "file bytes", _stats.looseFileBytes, _stats.atlasFileBytes);
+    }
+}
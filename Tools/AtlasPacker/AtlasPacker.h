@@ -0,0 +1,83 @@
+// Offline texture atlas packer: trims every frame sequence of an entity and packs them into
+// shared pages with cocos2d plist (format 2) metadata, so SpriteFrameCache resolves "plants/peashooter/%d.png"
+// 2026.10.17 by BillyDu
+#ifndef __ATLAS_PACKER_H__
+#define __ATLAS_PACKER_H__
+
+#include <cstddef>
+#include <cstdio>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "PngCodec.h"
+
+struct PackOptions {
+    std::string resourceRoot;                 // the game's Resources directory
+    std::string outputDir = "atlases";        // relative to resourceRoot
+    std::string manifest = "data/atlases.json";
+    std::vector<std::string> categories = { "plants", "zombies", "bullets" };
+    int maxPageSize = 2048;                   // square, power of two (GL ES 2 safe)
+    int padding = 2;                          // transparent pixels around each frame (no bleeding under linear filtering)
+    bool dryRun = false;                      // report only, write nothing
+};
+
+// Before / after numbers for the report
+struct PackStats {
+    int sequences = 0;          // frame directories ("plants/peashooter")
+    int groups = 0;             // entities (all sequences of one plant / zombie)
+    int looseTextures = 0;      // one texture per frame before packing
+    int pages = 0;              // atlas textures after packing
+    int skippedFiles = 0;       // GIFs and PNGs the codec cannot read
+    size_t looseGpuBytes = 0;   // RGBA8888, one texture per frame
+    size_t looseFileBytes = 0;
+    size_t atlasGpuBytes = 0;
+    size_t atlasFileBytes = 0;  // png + plist
+};
+
+class AtlasPacker {
+public:
+    explicit AtlasPacker(const PackOptions& options);
+
+    // Scan, pack and write; false with a message on the first hard error
+    bool run(std::string& error);
+
+    const PackStats& getStats() const { return _stats; }
+    void printReport(FILE* out) const;
+
+private:
+    // One trimmed frame waiting for a page (a group is decoded, packed and released before the next)
+    struct Frame {
+        std::string name;       // path relative to resourceRoot, used as the sprite frame name
+        RgbaImage pixels;       // trimmed
+        int sourceWidth = 0;
+        int sourceHeight = 0;
+        int trimX = 0;          // trimmed rect inside the source, top-left origin
+        int trimY = 0;
+        int pageX = 0;          // placement inside the page
+        int pageY = 0;
+    };
+
+    struct Page {
+        int width = 0;
+        int height = 0;
+        std::vector<Frame*> frames;
+    };
+
+    void scanDirectory(const std::string& group, const std::string& relativeDir);
+    bool packGroup(const std::string& group, const std::vector<std::string>& frameNames, std::string& error);
+    bool writePage(const std::string& baseName, const Page& page, std::string& error);
+    bool writeManifest(std::string& error);
+
+    // Shelf packing of frames[0..] in order; returns how many fit into width x height
+    size_t placeShelves(std::vector<Frame*>& frames, size_t first, int width, int height) const;
+
+    static void trim(const RgbaImage& source, Frame& frame);
+
+    PackOptions _options;
+    PackStats _stats;
+    std::map<std::string, std::vector<std::string>> _groups;  // group name -> frame names of all its sequences
+    std::vector<std::string> _plists;                         // written plists, relative to resourceRoot
+};
+
+#endif // __ATLAS_PACKER_H__
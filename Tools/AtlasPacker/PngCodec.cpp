@@ -0,0 +1,225 @@
+// PngCodec implementation
+// 2026.10.17 by BillyDu
+#include "PngCodec.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+#include <zlib.h>
+
+namespace {
+    const unsigned char PNG_SIGNATURE[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n' };
+
+    unsigned int readU32(const unsigned char* p) {
+        return (unsigned int)p[0] << 24 | (unsigned int)p[1] << 16 | (unsigned int)p[2] << 8 | p[3];
+    }
+
+    void writeU32(std::vector<unsigned char>& out, unsigned int v) {
+        out.push_back((unsigned char)(v >> 24));
+        out.push_back((unsigned char)(v >> 16));
+        out.push_back((unsigned char)(v >> 8));
+        out.push_back((unsigned char)v);
+    }
+
+    void writeChunk(std::vector<unsigned char>& out, const char* type, const std::vector<unsigned char>& data) {
+        writeU32(out, (unsigned int)data.size());
+        size_t typeStart = out.size();
+        out.insert(out.end(), type, type + 4);
+        out.insert(out.end(), data.begin(), data.end());
+        uLong crc = crc32(0L, &out[typeStart], (uInt)(out.size() - typeStart));
+        writeU32(out, (unsigned int)crc);
+    }
+
+    int paeth(int a, int b, int c) {
+        int p = a + b - c;
+        int pa = std::abs(p - a);
+        int pb = std::abs(p - b);
+        int pc = std::abs(p - c);
+        if (pa <= pb && pa <= pc) return a;
+        if (pb <= pc) return b;
+        return c;
+    }
+}
+
+bool loadPng(const std::string& path, RgbaImage& image, std::string& error) {
+    std::ifstream file(path.c_str(), std::ios::binary);
+    if (!file) {
+        error = "cannot open file";
+        return false;
+    }
+    std::vector<unsigned char> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    if (data.size() < 8 || memcmp(&data[0], PNG_SIGNATURE, 8) != 0) {
+        error = "not a PNG file";
+        return false;
+    }
+
+    int width = 0, height = 0, bitDepth = 0, colorType = 0, interlace = 0;
+    std::vector<unsigned char> palette;   // RGB triples
+    std::vector<unsigned char> paletteAlpha;
+    std::vector<unsigned char> idat;
+
+    size_t pos = 8;
+    while (pos + 12 <= data.size()) {
+        unsigned int length = readU32(&data[pos]);
+        std::string type(reinterpret_cast<const char*>(&data[pos + 4]), 4);
+        if (pos + 12 + length > data.size()) {
+            error = "truncated chunk " + type;
+            return false;
+        }
+        const unsigned char* body = &data[pos + 8];
+
+        if (type == "IHDR") {
+            width = (int)readU32(body);
+            height = (int)readU32(body + 4);
+            bitDepth = body[8];
+            colorType = body[9];
+            interlace = body[12];
+        }
+        else if (type == "PLTE") {
+            palette.assign(body, body + length);
+        }
+        else if (type == "tRNS") {
+            paletteAlpha.assign(body, body + length);
+        }
+        else if (type == "IDAT") {
+            idat.insert(idat.end(), body, body + length);
+        }
+        else if (type == "IEND") {
+            break;
+        }
+        pos += 12 + length;
+    }
+
+    if (width <= 0 || height <= 0) {
+        error = "missing IHDR";
+        return false;
+    }
+    if (bitDepth != 8 || interlace != 0) {
+        error = "only 8-bit non-interlaced PNGs are supported";
+        return false;
+    }
+
+    int channels = 0;
+    switch (colorType) {
+    case 0: channels = 1; break; // gray
+    case 2: channels = 3; break; // RGB
+    case 3: channels = 1; break; // palette
+    case 4: channels = 2; break; // gray + alpha
+    case 6: channels = 4; break; // RGBA
+    default:
+        error = "unknown color type";
+        return false;
+    }
+
+    size_t stride = (size_t)width * channels;
+    std::vector<unsigned char> raw((stride + 1) * height);
+    uLongf rawSize = (uLongf)raw.size();
+    if (uncompress(&raw[0], &rawSize, idat.empty() ? nullptr : &idat[0], (uLong)idat.size()) != Z_OK ||
+        rawSize != raw.size()) {
+        error = "corrupt image data";
+        return false;
+    }
+
+    // Undo the per-row filters in place
+    std::vector<unsigned char> prevRow(stride, 0);
+    std::vector<unsigned char> rows(stride * height);
+    for (int y = 0; y < height; ++y) {
+        unsigned char filter = raw[y * (stride + 1)];
+        unsigned char* row = &rows[y * stride];
+        memcpy(row, &raw[y * (stride + 1) + 1], stride);
+        for (size_t i = 0; i < stride; ++i) {
+            int left = i >= (size_t)channels ? row[i - channels] : 0;
+            int up = prevRow[i];
+            int upLeft = i >= (size_t)channels ? prevRow[i - channels] : 0;
+            switch (filter) {
+            case 0: break;
+            case 1: row[i] = (unsigned char)(row[i] + left); break;
+            case 2: row[i] = (unsigned char)(row[i] + up); break;
+            case 3: row[i] = (unsigned char)(row[i] + ((left + up) >> 1)); break;
+            case 4: row[i] = (unsigned char)(row[i] + paeth(left, up, upLeft)); break;
+            default:
+                error = "bad filter type";
+                return false;
+            }
+        }
+        memcpy(&prevRow[0], row, stride);
+    }
+
+    image.width = width;
+    image.height = height;
+    image.pixels.resize((size_t)width * height * 4);
+    for (int i = 0; i < width * height; ++i) {
+        const unsigned char* src = &rows[(size_t)i * channels];
+        unsigned char* dst = &image.pixels[(size_t)i * 4];
+        switch (colorType) {
+        case 0:
+            dst[0] = dst[1] = dst[2] = src[0];
+            dst[3] = 255;
+            break;
+        case 2:
+            dst[0] = src[0]; dst[1] = src[1]; dst[2] = src[2];
+            dst[3] = 255;
+            break;
+        case 3: {
+            size_t index = src[0];
+            if (index * 3 + 2 >= palette.size()) {
+                error = "palette index out of range";
+                return false;
+            }
+            dst[0] = palette[index * 3];
+            dst[1] = palette[index * 3 + 1];
+            dst[2] = palette[index * 3 + 2];
+            dst[3] = index < paletteAlpha.size() ? paletteAlpha[index] : 255;
+            break;
+        }
+        case 4:
+            dst[0] = dst[1] = dst[2] = src[0];
+            dst[3] = src[1];
+            break;
+        default:
+            memcpy(dst, src, 4);
+            break;
+        }
+    }
+    return true;
+}
+
+bool savePng(const std::string& path, const RgbaImage& image, std::string& error) {
+    size_t stride = (size_t)image.width * 4;
+    std::vector<unsigned char> raw((stride + 1) * image.height);
+    for (int y = 0; y < image.height; ++y) {
+        raw[y * (stride + 1)] = 0; // no filter
+        memcpy(&raw[y * (stride + 1) + 1], &image.pixels[y * stride], stride);
+    }
+
+    uLongf compressedSize = compressBound((uLong)raw.size());
+    std::vector<unsigned char> compressed(compressedSize);
+    if (compress2(&compressed[0], &compressedSize, &raw[0], (uLong)raw.size(), Z_BEST_COMPRESSION) != Z_OK) {
+        error = "compression failed";
+        return false;
+    }
+    compressed.resize(compressedSize);
+
+    std::vector<unsigned char> out(PNG_SIGNATURE, PNG_SIGNATURE + 8);
+    std::vector<unsigned char> header;
+    writeU32(header, (unsigned int)image.width);
+    writeU32(header, (unsigned int)image.height);
+    header.push_back(8);  // bit depth
+    header.push_back(6);  // RGBA
+    header.push_back(0);  // deflate
+    header.push_back(0);  // adaptive filtering
+    header.push_back(0);  // no interlace
+    writeChunk(out, "IHDR", header);
+    writeChunk(out, "IDAT", compressed);
+    writeChunk(out, "IEND", std::vector<unsigned char>());
+
+    std::ofstream file(path.c_str(), std::ios::binary);
+    if (!file) {
+        error = "cannot write file";
+        return false;
+    }
+    file.write(reinterpret_cast<const char*>(&out[0]), out.size());
+    return true;
+}
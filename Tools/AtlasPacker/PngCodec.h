@@ -0,0 +1,24 @@
+// Minimal PNG reader / writer for the atlas packer (8-bit, non-interlaced; zlib only)
+// 2026.10.17 by BillyDu
+#ifndef __PNG_CODEC_H__
+#define __PNG_CODEC_H__
+
+#include <string>
+#include <vector>
+
+// RGBA8888, rows top to bottom
+struct RgbaImage {
+    int width = 0;
+    int height = 0;
+    std::vector<unsigned char> pixels;
+
+    unsigned char alphaAt(int x, int y) const { return pixels[(y * width + x) * 4 + 3]; }
+};
+
+// Decode gray / RGB / palette / gray+alpha / RGBA at 8 bits per channel; error explains what is unsupported
+bool loadPng(const std::string& path, RgbaImage& image, std::string& error);
+
+// Encode as 8-bit RGBA
+bool savePng(const std::string& path, const RgbaImage& image, std::string& error);
+
+#endif // __PNG_CODEC_H__
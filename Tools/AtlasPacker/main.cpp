@@ -0,0 +1,54 @@
+// AtlasPacker command line: AtlasPacker <Resources dir> [--max-size N] [--padding N] [--dry-run]
+// 2026.10.17 by BillyDu
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include "AtlasPacker.h"
+
+static void printUsage() {
+    fprintf(stderr,
+            "usage: AtlasPacker <Resources dir> [--max-size N] [--padding N] [--dry-run]\n"
+            "  packs plants/, zombies/ and bullets/ frame sequences into <Resources>/atlases\n"
+            "  and lists the plists in <Resources>/data/atlases.json\n");
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        printUsage();
+        return 2;
+    }
+
+    PackOptions options;
+    options.resourceRoot = argv[1];
+    for (int i = 2; i < argc; ++i) {
+        if (strcmp(argv[i], "--max-size") == 0 && i + 1 < argc) {
+            options.maxPageSize = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--padding") == 0 && i + 1 < argc) {
+            options.padding = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--dry-run") == 0) {
+            options.dryRun = true;
+        }
+        else {
+            printUsage();
+            return 2;
+        }
+    }
+    if (options.maxPageSize < 64 || (options.maxPageSize & (options.maxPageSize - 1)) != 0) {
+        fprintf(stderr, "[Err] --max-size must be a power of two >= 64\n");
+        return 2;
+    }
+
+    AtlasPacker packer(options);
+    std::string error;
+    bool ok = packer.run(error);
+    packer.printReport(stdout);
+    if (!ok) {
+        fprintf(stderr, "[Err] %s\n", error.c_str());
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,185 @@
+// PvzBench scenario definitions and timing loop
+// 2026.10.17 by BillyDu
+#include "BenchScenarios.h"
+
+#include <algorithm>
+#include <chrono>
+
+#include "Sim/SimDataLoader.h"
+
+namespace {
+    // plants.json / zombies.json IDs used by the scenarios
+    const int CHERRY_BOMB = 1003;
+    const int POTATO_MINE = 1005;
+    const int REPEATER = 1008;
+    const int LILY_PAD = 1014;
+    const int NORMAL_ZOMBIE = 2001;
+    const int BOSS2 = 2005;
+
+    // `count` zombies of one type, round-robin over the lanes, all released within the first second
+    std::vector<SpawnEvent> makeHorde(int zombieId, int count, int rows) {
+        std::vector<SpawnEvent> waves;
+        for (int i = 0; i < count; ++i) {
+            SpawnEvent evt;
+            evt.time = (float)i / std::max(count, 1);
+            evt.zombieId = zombieId;
+            evt.row = i % rows;
+            waves.push_back(evt);
+        }
+        return waves;
+    }
+
+    // Plant in every free cell (LilyPad first on pool rows)
+    void fillLawn(Simulation& sim, int plantId) {
+        const LawnGeometry& geometry = sim.getGeometry();
+        for (int row = 0; row < geometry.rows; ++row) {
+            for (int col = 0; col < GRID_COLS; ++col) {
+                if ((sim.getTerrain(row, col) & TERRAIN_WATER) && sim.getPlantAt(row, col) == nullptr) {
+                    sim.tryPlantAt(LILY_PAD, row, col);
+                }
+                sim.tryPlantAt(plantId, row, col);
+            }
+        }
+    }
+
+    const char* outcomeName(GameState state) {
+        switch (state) {
+        case GameState::VICTORY: return "victory";
+        case GameState::GAME_OVER: return "game_over";
+        default: return "playing";
+        }
+    }
+}
+
+BenchRunner::BenchRunner(const BenchOptions& options)
+    : _options(options) {
+}
+
+bool BenchRunner::loadData(std::string& error) {
+    _data = SimDataLoader::loadSnapshot(_options.dataDir, error);
+    return _data != nullptr;
+}
+
+std::vector<BenchScenario> BenchRunner::createScenarios() const {
+    std::vector<BenchScenario> scenarios;
+    BenchOptions options = _options;
+
+    // 1. Full 6x9 pool lawn of Repeaters (LilyPads under the pool rows) against a horde
+    {
+        BenchScenario s;
+        s.name = "repeater_wall";
+        s.description = "6x9 Repeaters vs N zombies (bullet hits, lane index churn)";
+        s.configure = [options](SimSetup& setup) {
+            setup.mapId = 2;
+            setup.geometry = LawnGeometry::forMap(2);
+            setup.terrain = LawnTerrain::forMap(2);
+            setup.loadout = { REPEATER, LILY_PAD };
+            setup.waves = makeHorde(NORMAL_ZOMBIE, options.zombies, setup.geometry.rows);
+        };
+        s.populate = [](Simulation& sim) { fillLawn(sim, REPEATER); };
+        s.isDone = [](const Simulation& sim, const BenchResult&) { return sim.getState() != GameState::PLAYING; };
+        scenarios.push_back(s);
+    }
+
+    // 2. Boss2 sleds crushing a lawn of LilyPads that is replanted every tick
+    {
+        BenchScenario s;
+        s.name = "boss2_lilypads";
+        s.description = "Boss2 crushing a 5x9 LilyPad board, refilled every tick";
+        s.configure = [options](SimSetup& setup) {
+            setup.mapId = 1;
+            setup.geometry = LawnGeometry::forMap(1);
+            setup.loadout = { LILY_PAD };
+            setup.waves = makeHorde(BOSS2, options.bosses, setup.geometry.rows);
+        };
+        s.populate = [](Simulation& sim) { fillLawn(sim, LILY_PAD); };
+        s.step = [](Simulation& sim) { fillLawn(sim, LILY_PAD); };
+        s.isDone = [](const Simulation& sim, const BenchResult&) { return sim.getState() != GameState::PLAYING; };
+        scenarios.push_back(s);
+    }
+
+    // 3. Explosion storm: CherryBombs and PotatoMines on alternating cells, refilled every tick
+    {
+        BenchScenario s;
+        s.name = "explosion_storm";
+        s.description = "CherryBomb / PotatoMine storm over a horde until N explosions";
+        s.configure = [options](SimSetup& setup) {
+            setup.mapId = 1;
+            setup.geometry = LawnGeometry::forMap(1);
+            setup.loadout = { CHERRY_BOMB, POTATO_MINE };
+            setup.waves = makeHorde(NORMAL_ZOMBIE, options.zombies, setup.geometry.rows);
+        };
+        auto refill = [](Simulation& sim) {
+            for (int row = 0; row < sim.getGeometry().rows; ++row) {
+                for (int col = 0; col < GRID_COLS; ++col) {
+                    sim.tryPlantAt((row + col) % 2 == 0 ? CHERRY_BOMB : POTATO_MINE, row, col);
+                }
+            }
+        };
+        s.populate = [options](Simulation& sim) {
+            // Let the horde walk onto the lawn first (untimed), so mines get bitten
+            for (int i = 0; i < 180; ++i) sim.tick(options.tickSeconds);
+        };
+        s.step = refill;
+        s.isDone = [options](const Simulation& sim, const BenchResult& result) {
+            return result.explosions >= options.explosions || sim.getState() != GameState::PLAYING;
+        };
+        scenarios.push_back(s);
+    }
+
+    return scenarios;
+}
+
+BenchResult BenchRunner::run(const BenchScenario& scenario) const {
+    BenchResult result;
+    result.name = scenario.name;
+
+    SimSetup setup;
+    setup.data = _data;
+    setup.seed = _options.seed;
+    setup.autoCollectSun = true;
+    setup.freePlanting = true;
+    scenario.configure(setup);
+
+    Simulation sim(setup);
+    FrameProfiler profiler;
+    profiler.setEnabled(true);
+    sim.setProfiler(&profiler);
+
+    if (scenario.populate) scenario.populate(sim);
+    // Warm-up explosions do not count
+    unsigned long long explosionsBefore = sim.getEventTotal(SimEventType::EXPLOSION);
+
+    double totalNs = 0.0;
+    double combatNs = 0.0;
+    size_t allocsBefore = getAllocationCount();
+    while (result.ticks < _options.maxTicks && !scenario.isDone(sim, result)) {
+        if (scenario.step) scenario.step(sim);
+
+        profiler.beginFrame();
+        auto start = std::chrono::steady_clock::now();
+        sim.tick(_options.tickSeconds);
+        double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        profiler.endFrame();
+
+        totalNs += ns;
+        result.maxTickNs = std::max(result.maxTickNs, ns);
+        combatNs += (profiler.getLast(ProfilePhase::COMBAT_HITS) + profiler.getLast(ProfilePhase::COMBAT_BITES)) * 1000.0;
+        ++result.ticks;
+        result.explosions = (int)(sim.getEventTotal(SimEventType::EXPLOSION) - explosionsBefore);
+
+        result.peakZombies = std::max(result.peakZombies, sim.getZombies().size());
+        result.peakPlants = std::max(result.peakPlants, sim.getPlants().size());
+        result.peakBullets = std::max(result.peakBullets, sim.getBullets().size());
+    }
+    // Includes the scripted refills between ticks (they plant through the normal API)
+    size_t allocs = getAllocationCount() - allocsBefore;
+
+    if (result.ticks > 0) {
+        result.nsPerTick = totalNs / result.ticks;
+        result.combatNsPerTick = combatNs / result.ticks;
+        result.allocsPerTick = (double)allocs / result.ticks;
+    }
+    result.outcome = outcomeName(sim.getState());
+    return result;
+}
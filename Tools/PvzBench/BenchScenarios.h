@@ -0,0 +1,65 @@
+// PvzBench stress scenarios: scripted boards driven through the headless Simulation
+// 2026.10.17 by BillyDu
+#ifndef __BENCH_SCENARIOS_H__
+#define __BENCH_SCENARIOS_H__
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "Sim/Simulation.h"
+
+struct BenchOptions {
+    std::string dataDir;        // directory holding plants.json / zombies.json
+    int zombies = 500;          // horde size for the repeater / explosion scenarios
+    int bosses = 5;             // Boss2 count (one lane each, wraps)
+    int explosions = 500;       // explosion storm target
+    int maxTicks = 20000;       // safety cap per scenario
+    float tickSeconds = SIM_TICK_SECONDS;
+    unsigned int seed = 42;
+};
+
+struct BenchResult {
+    std::string name;
+    int ticks = 0;
+    double nsPerTick = 0.0;         // whole Simulation::tick
+    double combatNsPerTick = 0.0;   // updateCombatLogic (profiler phases 5A + 5B)
+    double maxTickNs = 0.0;
+    double allocsPerTick = 0.0;
+    size_t peakZombies = 0;
+    size_t peakPlants = 0;
+    size_t peakBullets = 0;
+    int explosions = 0;
+    std::string outcome;            // playing / victory / game_over
+};
+
+// One scripted board; populate runs before timing starts, step runs before every timed tick
+struct BenchScenario {
+    std::string name;
+    std::string description;
+    std::function<void(SimSetup&)> configure;
+    std::function<void(Simulation&)> populate;
+    std::function<void(Simulation&)> step;
+    std::function<bool(const Simulation&, const BenchResult&)> isDone;
+};
+
+class BenchRunner {
+public:
+    explicit BenchRunner(const BenchOptions& options);
+
+    // Reads plants.json / zombies.json once for every scenario
+    bool loadData(std::string& error);
+
+    std::vector<BenchScenario> createScenarios() const;
+    BenchResult run(const BenchScenario& scenario) const;
+
+private:
+    BenchOptions _options;
+    SimDataPtr _data;
+};
+
+// Provided by the bench executable (global operator new hook)
+size_t getAllocationCount();
+
+#endif // __BENCH_SCENARIOS_H__
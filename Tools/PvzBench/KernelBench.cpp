@@ -0,0 +1,108 @@
+// KernelBench implementation
+// 2026.10.17 by BillyDu
+#include "KernelBench.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "Sim/SimKernels.h"
+
+namespace {
+    // About 2e8 element updates per measurement, whatever the entity count
+    const double TARGET_UPDATES = 2e8;
+    const float BULLET_MAX_X = 1300.0f;
+
+    struct KernelResult {
+        const char* name;
+        double scalarNs = 0.0;  // per entity update
+        double simdNs = 0.0;
+        bool identical = false; // SIMD output bit-equal to the scalar loop
+    };
+
+    template <typename Fn>
+    double timeNsPerUpdate(int entities, int iterations, Fn&& fn) {
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; ++i) fn();
+        double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        return ns / ((double)entities * iterations);
+    }
+
+    KernelResult benchZombies(int entities, int iterations) {
+        std::mt19937 rng(42);
+        std::uniform_real_distribution<float> xs(0.0f, 1200.0f);
+        std::uniform_int_distribution<int> pick(0, 3);
+        std::vector<float> x(entities), speed(entities), multiplier(entities);
+        for (int i = 0; i < entities; ++i) {
+            x[i] = xs(rng);
+            // Mix of walkers, slowed walkers and eaters (speed 0), like a busy lawn
+            int kind = pick(rng);
+            speed[i] = kind == 0 ? 0.0f : 20.0f;
+            multiplier[i] = kind == 1 ? 0.5f : 1.0f;
+        }
+        const float dt = 1.0f / 60.0f;
+
+        KernelResult r;
+        r.name = "zombie_advance";
+        std::vector<float> scalarX = x;
+        std::vector<float> simdX = x;
+        r.scalarNs = timeNsPerUpdate(entities, iterations, [&]() {
+            SimKernels::advanceZombiesScalar(scalarX.data(), speed.data(), multiplier.data(), entities, dt);
+        });
+        r.simdNs = timeNsPerUpdate(entities, iterations, [&]() {
+            SimKernels::advanceZombies(simdX.data(), speed.data(), multiplier.data(), entities, dt);
+        });
+        r.identical = std::memcmp(scalarX.data(), simdX.data(), entities * sizeof(float)) == 0;
+        return r;
+    }
+
+    KernelResult benchBullets(int entities, int iterations) {
+        std::mt19937 rng(7);
+        std::uniform_real_distribution<float> xs(0.0f, 1200.0f);
+        std::vector<float> x(entities), speed(entities, 400.0f);
+        for (int i = 0; i < entities; ++i) x[i] = xs(rng);
+        // Small step so the whole run stays on screen except the bullets starting near the edge:
+        // the cull test runs every time, the rare cull path a few times
+        const float dt = 80.0f / 400.0f / iterations;
+
+        KernelResult r;
+        r.name = "bullet_advance";
+        std::vector<float> scalarX = x;
+        std::vector<float> simdX = x;
+        std::vector<uint32_t> scalarCulled, simdCulled;
+        scalarCulled.reserve(entities);
+        simdCulled.reserve(entities);
+        r.scalarNs = timeNsPerUpdate(entities, iterations, [&]() {
+            scalarCulled.clear();
+            SimKernels::advanceBulletsScalar(scalarX.data(), speed.data(), entities, dt, BULLET_MAX_X, scalarCulled);
+        });
+        r.simdNs = timeNsPerUpdate(entities, iterations, [&]() {
+            simdCulled.clear();
+            SimKernels::advanceBullets(simdX.data(), speed.data(), entities, dt, BULLET_MAX_X, simdCulled);
+        });
+        r.identical = std::memcmp(scalarX.data(), simdX.data(), entities * sizeof(float)) == 0 &&
+                      scalarCulled == simdCulled;
+        return r;
+    }
+}
+
+void runKernelBench(int entities, FILE* out) {
+    entities = std::max(entities, 1);
+    int iterations = std::max(1, (int)(TARGET_UPDATES / entities));
+
+    KernelResult results[] = { benchZombies(entities, iterations), benchBullets(entities, iterations) };
+
+    fprintf(out, "{\n  \"isa\": \"%s\",\n  \"entities\": %d,\n  \"iterations\": %d,\n  \"kernels\": [",
+            SimKernels::getIsaName(), entities, iterations);
+    bool first = true;
+    for (const KernelResult& r : results) {
+        fprintf(out, "%s\n    {\"name\": \"%s\", \"scalar_ns_per_entity\": %.3f, \"simd_ns_per_entity\": %.3f, "
+                     "\"speedup\": %.2f, \"simd_mentities_per_sec\": %.1f, \"identical\": %s}",
+                first ? "" : ",", r.name, r.scalarNs, r.simdNs, r.simdNs > 0.0 ? r.scalarNs / r.simdNs : 0.0,
+                r.simdNs > 0.0 ? 1000.0 / r.simdNs : 0.0, r.identical ? "true" : "false");
+        first = false;
+    }
+    fprintf(out, "\n  ]\n}\n");
+}
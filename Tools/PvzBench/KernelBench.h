@@ -0,0 +1,11 @@
+// PvzBench --kernels: SimKernels throughput at a fixed entity count, SIMD against the scalar loops
+// 2026.10.17 by BillyDu
+#ifndef __KERNEL_BENCH_H__
+#define __KERNEL_BENCH_H__
+
+#include <cstdio>
+
+// Writes {"isa", "entities", "kernels": [...]} as JSON to out
+void runKernelBench(int entities, FILE* out);
+
+#endif // __KERNEL_BENCH_H__
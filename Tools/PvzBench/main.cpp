@@ -0,0 +1,155 @@
+// PvzBench: stress scenarios for the headless Simulation, results as JSON
+//   PvzBench [--data <dir>] [--scenario <name>] [--zombies N] [--bosses N] [--explosions N]
+//            [--max-ticks N] [--out <file>]
+//   PvzBench --kernels [--entities N] [--out <file>]   (SIMD kernel throughput, default 10000 entities)
+// 2026.10.17 by BillyDu
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <string>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+#include "BenchScenarios.h"
+#include "KernelBench.h"
+
+#ifndef PVZ_BENCH_DATA_DIR
+#define PVZ_BENCH_DATA_DIR "Resources/data"
+#endif
+
+// --- Allocation counter: every operator new in the process goes through here ---
+static std::atomic<size_t> s_allocations{ 0 };
+
+size_t getAllocationCount() {
+    return s_allocations.load(std::memory_order_relaxed);
+}
+
+void* operator new(std::size_t size) {
+    s_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    s_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+
+// Peak resident set size in KB
+static long getPeakRssKb() {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return (long)(counters.PeakWorkingSetSize / 1024);
+    }
+    return 0;
+#else
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+    return usage.ru_maxrss / 1024; // bytes on macOS
+#else
+    return usage.ru_maxrss;        // KB on Linux
+#endif
+#endif
+}
+
+static void printUsage() {
+    fprintf(stderr,
+            "usage: PvzBench [--data <dir>] [--scenario <name>] [--zombies N] [--bosses N]\n"
+            "                [--explosions N] [--max-ticks N] [--out <file>]\n"
+            "       PvzBench --kernels [--entities N] [--out <file>]\n"
+            "  scenarios: repeater_wall, boss2_lilypads, explosion_storm (default: all)\n");
+}
+
+int main(int argc, char** argv) {
+    BenchOptions options;
+    options.dataDir = PVZ_BENCH_DATA_DIR;
+    std::string only;
+    std::string outPath;
+    bool kernels = false;
+    int entities = 10000;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--data" && hasValue) options.dataDir = argv[++i];
+        else if (arg == "--scenario" && hasValue) only = argv[++i];
+        else if (arg == "--zombies" && hasValue) options.zombies = atoi(argv[++i]);
+        else if (arg == "--bosses" && hasValue) options.bosses = atoi(argv[++i]);
+        else if (arg == "--explosions" && hasValue) options.explosions = atoi(argv[++i]);
+        else if (arg == "--max-ticks" && hasValue) options.maxTicks = atoi(argv[++i]);
+        else if (arg == "--out" && hasValue) outPath = argv[++i];
+        else if (arg == "--kernels") kernels = true;
+        else if (arg == "--entities" && hasValue) entities = atoi(argv[++i]);
+        else {
+            printUsage();
+            return 2;
+        }
+    }
+
+    FILE* out = stdout;
+    if (!outPath.empty()) {
+        out = fopen(outPath.c_str(), "w");
+        if (!out) {
+            fprintf(stderr, "[Err] Cannot write %s\n", outPath.c_str());
+            return 1;
+        }
+    }
+
+    // Kernel microbenchmark needs no game data
+    if (kernels) {
+        runKernelBench(entities, out);
+        if (out != stdout) fclose(out);
+        return 0;
+    }
+
+    BenchRunner runner(options);
+    std::string error;
+    if (!runner.loadData(error)) {
+        fprintf(stderr, "[Err] %s\n", error.c_str());
+        if (out != stdout) fclose(out);
+        return 1;
+    }
+
+    fprintf(out, "{\n  \"tickSeconds\": %.6f,\n  \"scenarios\": [", options.tickSeconds);
+    bool first = true;
+    int ran = 0;
+    for (const auto& scenario : runner.createScenarios()) {
+        if (!only.empty() && scenario.name != only) continue;
+
+        fprintf(stderr, "[Info] %s: %s\n", scenario.name.c_str(), scenario.description.c_str());
+        BenchResult r = runner.run(scenario);
+        ++ran;
+
+        fprintf(out, "%s\n    {\"name\": \"%s\", \"ticks\": %d, \"ns_per_tick\": %.1f, \"combat_ns_per_tick\": %.1f, "
+                     "\"max_tick_ns\": %.1f, \"allocs_per_tick\": %.2f, \"peak_zombies\": %zu, \"peak_plants\": %zu, "
+                     "\"peak_bullets\": %zu, \"explosions\": %d, \"outcome\": \"%s\", \"peak_rss_kb\": %ld}",
+                first ? "" : ",", r.name.c_str(), r.ticks, r.nsPerTick, r.combatNsPerTick, r.maxTickNs,
+                r.allocsPerTick, r.peakZombies, r.peakPlants, r.peakBullets, r.explosions, r.outcome.c_str(),
+                getPeakRssKb());
+        first = false;
+    }
+    fprintf(out, "\n  ]\n}\n");
+
+    if (out != stdout) fclose(out);
+    if (ran == 0) {
+        fprintf(stderr, "[Err] Unknown scenario: %s\n", only.c_str());
+        printUsage();
+        return 2;
+    }
+    return 0;
+}
@@ -0,0 +1,212 @@
+// PvzRun auto player
+// 2026.10.17 by BillyDu
+#include "AutoPlayer.h"
+
+#include <algorithm>
+
+namespace {
+    const float DECISION_INTERVAL = 0.25f;   // seconds of game time between decisions
+    const float DECISION_JITTER = 0.25f;     // extra random delay, a human is not frame-perfect
+    const int ECONOMY_COLS = 2;              // producers go in the two back columns
+    const int ATTACKER_LAST_COL = 5;
+    const int WALL_COL_MIN = 6;              // walls / spikes in front of the shooters
+    const float PANIC_COLS = 3.5f;           // zombie this close to the house -> spend an instant
+
+    // The whole cell lies left of x (a shooter in the zombie's own cell fires past it)
+    bool isLeftOf(const LawnGeometry& geometry, int col, float x) {
+        return geometry.cellCenterX(col) + geometry.cellWidth / 2 <= x;
+    }
+}
+
+AutoPlayer::AutoPlayer(const std::unordered_map<int, PlantData>& plants, const std::vector<int>& loadout,
+                       unsigned int seed)
+    : _plants(plants)
+    , _rng(seed) {
+    for (int id : loadout) {
+        auto it = plants.find(id);
+        if (it == plants.end()) continue;
+        const PlantData& data = it->second;
+        switch (data.behavior.kind) {
+        case PlantBehaviorKind::PLATFORM: _cards.lilyPad = id; break;
+        case PlantBehaviorKind::PRODUCER: _cards.producers.push_back(id); break;
+        case PlantBehaviorKind::SHOOTER: _cards.shooters.push_back(id); break;
+        case PlantBehaviorKind::BOMB:
+        case PlantBehaviorKind::MINE:
+        case PlantBehaviorKind::EATER: _cards.instants.push_back(id); break;
+        case PlantBehaviorKind::SPIKES: _cards.spikes.push_back(id); break;
+        default: _cards.walls.push_back(id); break;
+        }
+    }
+    _targetProducers = _cards.producers.empty() ? 0 : std::uniform_int_distribution<int>(4, 9)(_rng);
+}
+
+void AutoPlayer::update(Simulation& sim) {
+    if (sim.getTime() < _nextDecision) return;
+    _nextDecision = sim.getTime() + DECISION_INTERVAL +
+                    std::uniform_real_distribution<float>(0.0f, DECISION_JITTER)(_rng);
+
+    const LawnGeometry& geometry = sim.getGeometry();
+
+    // Leftmost zombie per row (closest to the house)
+    std::vector<float> nearest(geometry.rows, 1e9f);
+    const SimZombieStore& zombies = sim.getZombies();
+    for (size_t i = 0; i < zombies.size(); ++i) {
+        int row = zombies.row[i];
+        if (!zombies.isDead(i) && row < geometry.rows) {
+            nearest[row] = std::min(nearest[row], zombies.x[i]);
+        }
+    }
+
+    // 1. Emergencies first: the closest zombie that has broken through
+    int panicRow = -1;
+    float panicX = geometry.startX + PANIC_COLS * geometry.cellWidth;
+    for (int row = 0; row < geometry.rows; ++row) {
+        if (nearest[row] < panicX) {
+            panicX = nearest[row];
+            panicRow = row;
+        }
+    }
+    if (panicRow >= 0 && defendLane(sim, panicRow, panicX)) return;
+
+    // Rows ordered by threat (nearest zombie first), ties shuffled
+    std::vector<int> rows(geometry.rows);
+    for (int row = 0; row < geometry.rows; ++row) rows[row] = row;
+    std::shuffle(rows.begin(), rows.end(), _rng);
+    std::stable_sort(rows.begin(), rows.end(), [&nearest](int a, int b) { return nearest[a] < nearest[b]; });
+
+    // 2. Economy while the lawn is quiet, 3. attackers, 4. walls in threatened rows
+    bool quiet = nearest[rows[0]] > geometry.cellCenterX(GRID_COLS - 2);
+    if (quiet && plantEconomy(sim, nearest)) return;
+    if (plantAttacker(sim, rows, nearest)) return;
+    if (!quiet && plantEconomy(sim, nearest)) return;
+
+    for (int row : rows) {
+        if (nearest[row] > 1e8f) break;
+        int col = WALL_COL_MIN + std::uniform_int_distribution<int>(0, 1)(_rng);
+        // Without a shooter behind it a wall only parks the zombie there for good
+        if (!_cards.walls.empty() && isCovered(sim, row, geometry.cellCenterX(col)) &&
+            plant(sim, pick(_cards.walls, sim), row, col)) return;
+        if (!_cards.spikes.empty() && plant(sim, pick(_cards.spikes, sim), row, col + 1)) return;
+    }
+}
+
+bool AutoPlayer::defendLane(Simulation& sim, int row, float zombieX) {
+    const LawnGeometry& geometry = sim.getGeometry();
+    int zombieCol = (int)((zombieX - geometry.startX) / geometry.cellWidth);
+    zombieCol = std::max(0, std::min(zombieCol, GRID_COLS - 1));
+    for (int id : _cards.instants) {
+        if (!isReady(sim, id)) continue;
+        if (_plants.at(id).behavior.kind == PlantBehaviorKind::BOMB) {
+            // CherryBomb: any free cell of the 3x3 around the zombie still hits it
+            // (its own cell is often taken by the plant it is eating)
+            for (int dr : { 0, -1, 1 }) {
+                for (int dc : { 0, -1, 1 }) {
+                    int r = row + dr;
+                    int c = zombieCol + dc;
+                    if (r < 0 || r >= geometry.rows || c < 0 || c >= GRID_COLS) continue;
+                    if (plant(sim, id, r, c)) return true;
+                }
+            }
+            continue;
+        }
+        // PotatoMine / Chomper just in front of it
+        if (plant(sim, id, row, std::max(0, zombieCol - 1))) return true;
+    }
+    // Otherwise a wall in front of it, if something behind the wall can shoot
+    if (!_cards.walls.empty() && zombieCol > 0 && isCovered(sim, row, geometry.cellCenterX(zombieCol - 1))) {
+        return plant(sim, pick(_cards.walls, sim), row, zombieCol - 1);
+    }
+    return false;
+}
+
+bool AutoPlayer::plantEconomy(Simulation& sim, const std::vector<float>& nearest) {
+    if (_cards.producers.empty()) return false;
+    int producers = 0;
+    for (const auto& p : sim.getPlants()) {
+        if (p->data->behavior.kind == PlantBehaviorKind::PRODUCER) ++producers;
+    }
+    if (producers >= _targetProducers) return false;
+
+    int id = pick(_cards.producers, sim);
+    if (!isReady(sim, id)) return false;
+    const LawnGeometry& geometry = sim.getGeometry();
+    int start = std::uniform_int_distribution<int>(0, geometry.rows - 1)(_rng);
+    for (int col = 0; col < ECONOMY_COLS; ++col) {
+        for (int i = 0; i < geometry.rows; ++i) {
+            int row = (start + i) % geometry.rows;
+            if (!isLeftOf(geometry, col, nearest[row])) continue;
+            if (plant(sim, id, row, col)) return true;
+        }
+    }
+    return false;
+}
+
+bool AutoPlayer::plantAttacker(Simulation& sim, const std::vector<int>& rowsByThreat, const std::vector<float>& nearest) {
+    if (_cards.shooters.empty()) return false;
+
+    int id = pick(_cards.shooters, sim);
+    if (!isReady(sim, id)) return false;
+    const LawnGeometry& geometry = sim.getGeometry();
+    // Leftmost free attacker column in the most threatened row that still has room; the economy
+    // columns too once the row's zombies have walked into the attacker columns
+    for (int row : rowsByThreat) {
+        bool breached = nearest[row] < geometry.cellCenterX(ATTACKER_LAST_COL + 1);
+        int firstCol = (_cards.producers.empty() || breached) ? 0 : ECONOMY_COLS;
+        for (int col = firstCol; col <= ATTACKER_LAST_COL; ++col) {
+            if (!isLeftOf(geometry, col, nearest[row])) break;
+            if (plant(sim, id, row, col)) return true;
+        }
+    }
+
+    // A lane under attack with no room for a shooter behind its zombies (producers fill it, and a
+    // wall keeps the zombies in place): trade the producer closest to them for the shooter
+    for (int row : rowsByThreat) {
+        if (nearest[row] > 1e8f) break;
+        if (isCovered(sim, row, nearest[row])) continue;
+        const SimPlant* producer = nullptr;
+        for (const auto& p : sim.getPlants()) {
+            if (p->row != row || !isLeftOf(geometry, p->col, nearest[row])) continue;
+            if (p->data->behavior.kind == PlantBehaviorKind::PRODUCER && (!producer || p->col > producer->col)) {
+                producer = p.get();
+            }
+        }
+        if (!producer) continue;
+        int col = producer->col;
+        if (sim.tryDigAt(row, col) && plant(sim, id, row, col)) return true;
+    }
+    return false;
+}
+
+bool AutoPlayer::plant(Simulation& sim, int plantId, int row, int col) {
+    if (!isReady(sim, plantId)) return false;
+    if ((sim.getTerrain(row, col) & TERRAIN_WATER) && sim.getPlantAt(row, col) == nullptr) {
+        // The LilyPad uses this decision; the plant goes on top next time
+        return _cards.lilyPad != 0 && sim.tryPlantAt(_cards.lilyPad, row, col);
+    }
+    return sim.tryPlantAt(plantId, row, col);
+}
+
+bool AutoPlayer::isReady(const Simulation& sim, int plantId) const {
+    auto it = _plants.find(plantId);
+    return it != _plants.end() && sim.getCooldownRemaining(plantId) <= 0.0f && sim.getSun() >= it->second.cost;
+}
+
+bool AutoPlayer::isCovered(const Simulation& sim, int row, float x) const {
+    for (const auto& p : sim.getPlants()) {
+        if (p->row == row && p->data->behavior.kind == PlantBehaviorKind::SHOOTER &&
+            isLeftOf(sim.getGeometry(), p->col, x)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Random card among those ready to plant, or any card when none is
+int AutoPlayer::pick(const std::vector<int>& cards, const Simulation& sim) {
+    std::vector<int> ready;
+    for (int id : cards) {
+        if (isReady(sim, id)) ready.push_back(id);
+    }
+    const std::vector<int>& from = ready.empty() ? cards : ready;
+    return from[std::uniform_int_distribution<size_t>(0, from.size() - 1)(_rng)];
+}
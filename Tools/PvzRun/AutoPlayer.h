@@ -0,0 +1,52 @@
+// PvzRun: scripted stand-in for a player, used when no placement script is given (--auto, PvzBatch)
+// Greedy and seeded: the same seed always plays the same game, different seeds vary the choices
+// 2026.10.17 by BillyDu
+#ifndef __AUTO_PLAYER_H__
+#define __AUTO_PLAYER_H__
+
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+#include "Sim/Simulation.h"
+
+class AutoPlayer {
+public:
+    AutoPlayer(const std::unordered_map<int, PlantData>& plants, const std::vector<int>& loadout, unsigned int seed);
+
+    // Called before every tick; acts every DECISION_INTERVAL of game time
+    void update(Simulation& sim);
+
+private:
+    // Loadout cards by plants.json "type"
+    struct Cards {
+        std::vector<int> producers;
+        std::vector<int> shooters;
+        std::vector<int> walls;      // defensive with a big HP pool (WallNut, TallNut)
+        std::vector<int> spikes;     // defensive that attacks (Spikeweed)
+        std::vector<int> instants;   // CherryBomb, PotatoMine, Chomper
+        int lilyPad = 0;
+    };
+
+    // Each returns true when something was planted (one plant per decision keeps sun spending spread out)
+    bool defendLane(Simulation& sim, int row, float zombieX);
+    // Both only use cells left of the row's nearest zombie: a shooter behind it never fires, and a
+    // producer in its path is just food that keeps it standing there
+    bool plantEconomy(Simulation& sim, const std::vector<float>& nearest);
+    bool plantAttacker(Simulation& sim, const std::vector<int>& rowsByThreat, const std::vector<float>& nearest);
+
+    // Plant (LilyPad first on pool rows); false when the cell, sun or cooldown forbids it
+    bool plant(Simulation& sim, int plantId, int row, int col);
+    bool isReady(const Simulation& sim, int plantId) const;
+    // A shooter stands in the row left of x (a wall in front of it buys time instead of a stalemate)
+    bool isCovered(const Simulation& sim, int row, float x) const;
+    int pick(const std::vector<int>& cards, const Simulation& sim);
+
+    const std::unordered_map<int, PlantData>& _plants;
+    Cards _cards;
+    std::mt19937 _rng;
+    float _nextDecision = 0.0f;
+    int _targetProducers = 0;    // how greedy this game is on economy
+};
+
+#endif // __AUTO_PLAYER_H__
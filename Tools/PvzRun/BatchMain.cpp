@@ -0,0 +1,243 @@
+// PvzBatch: Monte Carlo win rates for every loadout of a level, results as CSV
+//   PvzBatch --level data/level_map2.json [--games N] [--cards N] [--plants <id,...>] [--require <id,...>]
+//            [--seed N] [--threads N] [--data <dir>] [--map N] [--sun N] [--max-time <seconds>] [--out <file>]
+// Each game is one AutoPlayer run; game g uses seed + g for every loadout, so loadouts are compared
+// on the same draws
+// 2026.10.17 by BillyDu
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "LevelRunner.h"
+#include "WorkStealingPool.h"
+
+namespace {
+    // Same as PlantSelectScene::MAX_SELECTED_CARDS (the scene header pulls in cocos2d)
+    const int MAX_SELECTED_CARDS = 8;
+    // Games per pool task: big enough to amortize the task, small enough to balance the tail
+    const int GAMES_PER_TASK = 8;
+
+    struct GameOutcome {
+        GameState state = GameState::PLAYING;
+        float simSeconds = 0.0f;
+    };
+
+    struct LoadoutStats {
+        std::vector<int> loadout;
+        int games = 0;
+        int wins = 0;
+        int losses = 0;
+        int timeouts = 0;
+        double winRate = 0.0;
+        double meanTtv = 0.0;   // time to victory over the won games
+        float ttv[5] = {};      // p10 p25 p50 p75 p90
+    };
+
+    void printUsage() {
+        fprintf(stderr,
+                "usage: PvzBatch --level <file> [--games N] [--cards N] [--plants <id,...>] [--require <id,...>]\n"
+                "                [--seed N] [--threads N] [--data <dir>] [--map N] [--sun N]\n"
+                "                [--max-time <seconds>] [--out <file>]\n"
+                "  --cards    loadout size (default %d, PlantSelectScene::MAX_SELECTED_CARDS)\n"
+                "  --plants   candidate cards (default: every plant in plants.json)\n"
+                "  --require  cards every loadout must contain (e.g. 1014 on pool maps)\n",
+                MAX_SELECTED_CARDS);
+    }
+
+    // Every `size`-card subset of `pool` that contains all of `required`
+    std::vector<std::vector<int>> enumerateLoadouts(const std::vector<int>& pool, const std::vector<int>& required,
+                                                    int size) {
+        std::vector<int> rest;
+        for (int id : pool) {
+            if (std::find(required.begin(), required.end(), id) == required.end()) rest.push_back(id);
+        }
+        std::vector<std::vector<int>> loadouts;
+        int pick = size - (int)required.size();
+        if (pick < 0 || pick > (int)rest.size()) return loadouts;
+
+        std::vector<int> index(pick);
+        for (int i = 0; i < pick; ++i) index[i] = i;
+        for (;;) {
+            std::vector<int> loadout = required;
+            for (int i : index) loadout.push_back(rest[i]);
+            std::sort(loadout.begin(), loadout.end());
+            loadouts.push_back(loadout);
+
+            // Next combination in lexicographic order
+            int i = pick - 1;
+            while (i >= 0 && index[i] == (int)rest.size() - pick + i) --i;
+            if (i < 0) break;
+            ++index[i];
+            for (int j = i + 1; j < pick; ++j) index[j] = index[j - 1] + 1;
+        }
+        return loadouts;
+    }
+
+    float percentile(const std::vector<float>& sorted, double p) {
+        if (sorted.empty()) return 0.0f;
+        size_t rank = (size_t)(p / 100.0 * (sorted.size() - 1) + 0.5);
+        return sorted[std::min(rank, sorted.size() - 1)];
+    }
+
+    LoadoutStats summarize(const std::vector<int>& loadout, const GameOutcome* games, int count) {
+        LoadoutStats stats;
+        stats.loadout = loadout;
+        stats.games = count;
+        std::vector<float> ttv;
+        for (int i = 0; i < count; ++i) {
+            if (games[i].state == GameState::VICTORY) {
+                ttv.push_back(games[i].simSeconds);
+            }
+            else if (games[i].state == GameState::GAME_OVER) {
+                ++stats.losses;
+            }
+            else {
+                ++stats.timeouts;
+            }
+        }
+        stats.wins = (int)ttv.size();
+        stats.winRate = count > 0 ? (double)stats.wins / count : 0.0;
+        if (!ttv.empty()) {
+            std::sort(ttv.begin(), ttv.end());
+            double sum = 0.0;
+            for (float t : ttv) sum += t;
+            stats.meanTtv = sum / ttv.size();
+            const double ranks[5] = { 10.0, 25.0, 50.0, 75.0, 90.0 };
+            for (int i = 0; i < 5; ++i) stats.ttv[i] = percentile(ttv, ranks[i]);
+        }
+        return stats;
+    }
+}
+
+int main(int argc, char** argv) {
+    std::string levelPath;
+    std::string dataDir;
+    std::string outPath;
+    std::vector<int> pool;
+    std::vector<int> required;
+    int games = 200;
+    int cards = MAX_SELECTED_CARDS;
+    int mapId = 0;
+    unsigned int threads = 0;
+    unsigned int seed = 1;
+    RunOptions base;
+    base.autoPlay = true;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--level" && hasValue) levelPath = argv[++i];
+        else if (arg == "--games" && hasValue) games = atoi(argv[++i]);
+        else if (arg == "--cards" && hasValue) cards = atoi(argv[++i]);
+        else if (arg == "--plants" && hasValue && LevelRunner::parseIdList(argv[i + 1], pool)) ++i;
+        else if (arg == "--require" && hasValue && LevelRunner::parseIdList(argv[i + 1], required)) ++i;
+        else if (arg == "--seed" && hasValue) seed = (unsigned int)strtoul(argv[++i], nullptr, 10);
+        else if (arg == "--threads" && hasValue) threads = (unsigned int)atoi(argv[++i]);
+        else if (arg == "--data" && hasValue) dataDir = argv[++i];
+        else if (arg == "--map" && hasValue) mapId = atoi(argv[++i]);
+        else if (arg == "--sun" && hasValue) base.initialSun = atoi(argv[++i]);
+        else if (arg == "--max-time" && hasValue) base.maxSimSeconds = (float)atof(argv[++i]);
+        else if (arg == "--out" && hasValue) outPath = argv[++i];
+        else {
+            printUsage();
+            return 2;
+        }
+    }
+    if (levelPath.empty() || games <= 0 || cards <= 0) {
+        printUsage();
+        return 2;
+    }
+    if (dataDir.empty()) {
+        size_t slash = levelPath.find_last_of("/\\");
+        dataDir = (slash == std::string::npos) ? "." : levelPath.substr(0, slash);
+    }
+    base.mapId = mapId > 0 ? mapId : LevelRunner::mapIdFromLevelPath(levelPath);
+
+    LevelRunner runner;
+    std::string error;
+    if (!runner.loadData(dataDir, levelPath, base.mapId, error)) {
+        fprintf(stderr, "[Err] %s\n", error.c_str());
+        return 2;
+    }
+    if (pool.empty()) {
+        for (const auto& entry : runner.getPlants()) pool.push_back(entry.first);
+    }
+    std::sort(pool.begin(), pool.end());
+    cards = std::min(cards, (int)pool.size());
+
+    std::vector<std::vector<int>> loadouts = enumerateLoadouts(pool, required, cards);
+    if (loadouts.empty()) {
+        fprintf(stderr, "[Err] No %d-card loadout contains every --require card\n", cards);
+        return 2;
+    }
+
+    // One slot per game, written by exactly one task: no locking around results
+    std::vector<GameOutcome> outcomes(loadouts.size() * games);
+    auto start = std::chrono::steady_clock::now();
+    {
+        // One reusable Simulation per worker thread, indexed by the worker the task runs on
+        // (declared before the pool so it outlives the worker threads)
+        std::vector<RunWorkspace> workspaces;
+        WorkStealingPool workers(threads);
+        workspaces.resize(workers.getThreadCount());
+        fprintf(stderr, "[Info] %zu loadouts x %d games on %u threads\n",
+                loadouts.size(), games, workers.getThreadCount());
+
+        for (size_t l = 0; l < loadouts.size(); ++l) {
+            for (int first = 0; first < games; first += GAMES_PER_TASK) {
+                int last = std::min(games, first + GAMES_PER_TASK);
+                GameOutcome* slots = &outcomes[l * games];
+                const std::vector<int>* loadout = &loadouts[l];
+                workers.submit([&runner, &base, &workspaces, slots, loadout, first, last, seed](unsigned int worker) {
+                    RunWorkspace& workspace = workspaces[worker];
+                    RunOptions options = base;
+                    options.loadout = *loadout;
+                    for (int g = first; g < last; ++g) {
+                        options.seed = seed + (unsigned int)g;
+                        RunResult r = runner.run(options, workspace);
+                        slots[g].state = r.state;
+                        slots[g].simSeconds = r.simSeconds;
+                    }
+                });
+            }
+        }
+        workers.wait();
+    }
+    double wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    fprintf(stderr, "[Info] %zu games in %.2f s (%.0f games/s)\n",
+            outcomes.size(), wallSeconds, outcomes.size() / std::max(wallSeconds, 1e-9));
+
+    std::vector<LoadoutStats> stats;
+    for (size_t l = 0; l < loadouts.size(); ++l) {
+        stats.push_back(summarize(loadouts[l], &outcomes[l * games], games));
+    }
+    // Best first: highest win rate, then fastest median victory
+    std::stable_sort(stats.begin(), stats.end(), [](const LoadoutStats& a, const LoadoutStats& b) {
+        if (a.winRate != b.winRate) return a.winRate > b.winRate;
+        return a.ttv[2] < b.ttv[2];
+    });
+
+    FILE* out = stdout;
+    if (!outPath.empty()) {
+        out = fopen(outPath.c_str(), "w");
+        if (!out) {
+            fprintf(stderr, "[Err] Cannot write %s\n", outPath.c_str());
+            return 2;
+        }
+    }
+    fprintf(out, "loadout,games,wins,losses,timeouts,win_rate,ttv_mean,ttv_p10,ttv_p25,ttv_p50,ttv_p75,ttv_p90\n");
+    for (const auto& s : stats) {
+        std::string loadout;
+        for (int id : s.loadout) {
+            if (!loadout.empty()) loadout += ' ';
+            loadout += std::to_string(id);
+        }
+        fprintf(out, "%s,%d,%d,%d,%d,%.4f,%.2f,%.2f,%.2f,%.2f,%.2f,%.2f\n", loadout.c_str(), s.games, s.wins,
+                s.losses, s.timeouts, s.winRate, s.meanTtv, s.ttv[0], s.ttv[1], s.ttv[2], s.ttv[3], s.ttv[4]);
+    }
+    if (out != stdout) fclose(out);
+    return 0;
+}
@@ -0,0 +1,159 @@
+// PvzRun level runner
+// 2026.10.17 by BillyDu
+#include "LevelRunner.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <memory>
+#include <sstream>
+#include <thread>
+
+#include "AutoPlayer.h"
+#include "Sim/SimDataLoader.h"
+#include "Sim/SimJson.h"
+
+bool LevelRunner::loadData(const std::string& dataDir, const std::string& levelPath, int mapId, std::string& error) {
+    _data = SimDataLoader::loadSnapshot(dataDir, error);
+    if (!_data || !SimDataLoader::loadWaves(levelPath, _waves, error) ||
+        !SimDataLoader::loadTerrain(levelPath, _terrain, error)) {
+        return false;
+    }
+    if (!SimDataLoader::validateWaves(_waves, *_data, LawnGeometry::forMap(mapId), error)) {
+        error = levelPath + ": " + error;
+        return false;
+    }
+    return true;
+}
+
+bool LevelRunner::loadScript(const std::string& path, std::vector<ScriptAction>& actions, std::string& error) {
+    JsonValue doc;
+    if (!JsonValue::parseFile(path, doc, error)) {
+        return false;
+    }
+    const JsonValue* list = doc.isArray() ? &doc : doc.find("actions");
+    if (!list || !list->isArray()) {
+        error = path + ": expected an \"actions\" array";
+        return false;
+    }
+
+    actions.clear();
+    for (size_t i = 0; i < list->size(); ++i) {
+        const JsonValue& item = (*list)[i];
+        if (!item.isObject()) {
+            error = path + ": action " + std::to_string(i) + " is not an object";
+            return false;
+        }
+        ScriptAction action;
+        std::string kind = item.getString("action", "plant");
+        if (kind == "dig") {
+            action.kind = ScriptAction::Kind::DIG;
+        }
+        else if (kind != "plant") {
+            error = path + ": unknown action \"" + kind + "\"";
+            return false;
+        }
+        action.time = item.getFloat("time", 0.0f);
+        action.plantId = item.getInt("plantId", 0);
+        action.row = item.getInt("row", -1);
+        action.col = item.getInt("col", -1);
+        if (action.kind == ScriptAction::Kind::PLANT && action.plantId == 0) {
+            error = path + ": action " + std::to_string(i) + " has no plantId";
+            return false;
+        }
+        actions.push_back(action);
+    }
+    return true;
+}
+
+int LevelRunner::mapIdFromLevelPath(const std::string& path) {
+    if (path.find("level_map2") != std::string::npos) return 2;
+    if (path.find("level_map4") != std::string::npos) return 4;
+    return 1;
+}
+
+bool LevelRunner::parseIdList(const std::string& text, std::vector<int>& ids) {
+    std::stringstream ss(text);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        if (item.empty()) continue;
+        char* end = nullptr;
+        long id = strtol(item.c_str(), &end, 10);
+        if (*end != '\0') return false;
+        ids.push_back((int)id);
+    }
+    return !ids.empty();
+}
+
+const char* LevelRunner::outcomeName(GameState state) {
+    switch (state) {
+    case GameState::VICTORY: return "victory";
+    case GameState::GAME_OVER: return "game_over";
+    default: return "playing";
+    }
+}
+
+RunResult LevelRunner::run(const RunOptions& options) const {
+    RunWorkspace workspace;
+    return run(options, workspace);
+}
+
+RunResult LevelRunner::run(const RunOptions& options, RunWorkspace& workspace) const {
+    SimSetup setup;
+    setup.mapId = options.mapId;
+    setup.geometry = LawnGeometry::forMap(options.mapId);
+    setup.terrain = _terrain;
+    setup.data = _data;
+    setup.waves = _waves;
+    setup.loadout = options.loadout;
+    setup.initialSun = options.initialSun;
+    setup.seed = options.seed;
+    setup.autoCollectSun = true; // nobody clicks suns headless
+
+    if (workspace.sim) {
+        workspace.sim->reset(setup);
+    }
+    else {
+        workspace.sim.reset(new Simulation(setup));
+    }
+    Simulation& sim = *workspace.sim;
+    std::unique_ptr<AutoPlayer> player;
+    if (options.autoPlay) {
+        player.reset(new AutoPlayer(_data->getPlants(), options.loadout, options.seed));
+    }
+
+    RunResult result;
+    result.actionsTotal = options.script.size();
+    auto start = std::chrono::steady_clock::now();
+    auto nextTick = start;
+    auto tickDuration = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(SIM_TICK_SECONDS));
+
+    while (sim.getState() == GameState::PLAYING && sim.getTime() < options.maxSimSeconds) {
+        // Script: in order, the head waits until it succeeds
+        while (result.actionsDone < options.script.size()) {
+            const ScriptAction& action = options.script[result.actionsDone];
+            if (action.time > sim.getTime()) break;
+            bool done = (action.kind == ScriptAction::Kind::DIG)
+                ? sim.tryDigAt(action.row, action.col)
+                : sim.tryPlantAt(action.plantId, action.row, action.col);
+            if (!done) break;
+            ++result.actionsDone;
+        }
+        if (player && result.actionsDone == options.script.size()) {
+            player->update(sim);
+        }
+
+        sim.tick(SIM_TICK_SECONDS);
+
+        if (!options.maxSpeed) {
+            nextTick += tickDuration;
+            std::this_thread::sleep_until(nextTick);
+        }
+    }
+
+    result.wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    result.state = sim.getState();
+    result.simSeconds = sim.getTime();
+    result.ticks = sim.getTickCount();
+    return result;
+}
@@ -0,0 +1,80 @@
+// PvzRun: plays one level headlessly with a fixed loadout and an optional placement script
+// 2026.10.17 by BillyDu
+#ifndef __LEVEL_RUNNER_H__
+#define __LEVEL_RUNNER_H__
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Sim/Simulation.h"
+
+// One scripted player command; executed in file order, each once its time has come
+// (a plant waits until sun / cooldown allow it, like a player holding the card)
+struct ScriptAction {
+    enum class Kind { PLANT, DIG };
+    Kind kind = Kind::PLANT;
+    float time = 0.0f;
+    int plantId = 0;
+    int row = 0;
+    int col = 0;
+};
+
+struct RunOptions {
+    int mapId = 1;
+    std::vector<int> loadout;
+    std::vector<ScriptAction> script;
+    unsigned int seed = 0;
+    int initialSun = 500;
+    float maxSimSeconds = 900.0f;  // give up (outcome "playing") after this much game time
+    bool maxSpeed = true;          // false: pace ticks to real time
+    bool autoPlay = false;         // AutoPlayer plays the loadout (after the script, if any)
+};
+
+struct RunResult {
+    GameState state = GameState::PLAYING;
+    float simSeconds = 0.0f;
+    double wallSeconds = 0.0;
+    unsigned long long ticks = 0;
+    size_t actionsDone = 0;
+    size_t actionsTotal = 0;
+};
+
+// Per-worker state: the Simulation of the previous game is reset instead of rebuilt, so its entity
+// arrays, timer nodes and scratch buffers are reused. Owned by exactly one thread at a time
+struct RunWorkspace {
+    std::unique_ptr<Simulation> sim;
+};
+
+class LevelRunner {
+public:
+    // plants.json / zombies.json from dataDir, waves and terrain from levelPath (run() is safe to call from many threads)
+    // Waves are checked against the zombie table and the rows of mapId's lawn
+    bool loadData(const std::string& dataDir, const std::string& levelPath, int mapId, std::string& error);
+
+    // {"actions": [{"time": 0, "plantId": 1002, "row": 0, "col": 0}, {"time": 40, "action": "dig", ...}]}
+    // A bare top-level array of actions is accepted too
+    static bool loadScript(const std::string& path, std::vector<ScriptAction>& actions, std::string& error);
+
+    // level_map2.json -> 2, level_map4.json -> 4, anything else -> 1 (same as LevelManager::getLevelFile)
+    static int mapIdFromLevelPath(const std::string& path);
+
+    // "1001,1002,1014" -> ids (appended); false on a non-numeric entry or an empty list
+    static bool parseIdList(const std::string& text, std::vector<int>& ids);
+
+    static const char* outcomeName(GameState state);
+
+    RunResult run(const RunOptions& options) const;
+    // Same, playing on the workspace's Simulation (created on first use)
+    RunResult run(const RunOptions& options, RunWorkspace& workspace) const;
+
+    const std::unordered_map<int, PlantData>& getPlants() const { return _data->getPlants(); }
+
+private:
+    SimDataPtr _data;  // shared by every game, on every worker thread
+    std::vector<SpawnEvent> _waves;
+    LawnTerrain _terrain;
+};
+
+#endif // __LEVEL_RUNNER_H__
@@ -0,0 +1,90 @@
+// Work-stealing thread pool
+// 2026.10.17 by BillyDu
+#include "WorkStealingPool.h"
+
+#include <algorithm>
+
+WorkStealingPool::WorkStealingPool(unsigned int threads) {
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    for (unsigned int i = 0; i < threads; ++i) {
+        _queues.emplace_back(new WorkQueue());
+    }
+    for (unsigned int i = 0; i < threads; ++i) {
+        _threads.emplace_back(&WorkStealingPool::workerLoop, this, i);
+    }
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    wait();
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stop = true;
+    }
+    _workReady.notify_all();
+    for (auto& thread : _threads) {
+        thread.join();
+    }
+}
+
+void WorkStealingPool::submit(Task task) {
+    _unfinished.fetch_add(1);
+    {
+        // Counted before the push (a worker never sees the count drop below zero),
+        // under the pool mutex so a worker about to sleep cannot miss the wake-up
+        std::lock_guard<std::mutex> lock(_mutex);
+        _queued.fetch_add(1);
+    }
+    unsigned int index = _nextQueue.fetch_add(1) % _queues.size();
+    {
+        std::lock_guard<std::mutex> lock(_queues[index]->mutex);
+        _queues[index]->tasks.push_back(std::move(task));
+    }
+    _workReady.notify_one();
+}
+
+void WorkStealingPool::wait() {
+    std::unique_lock<std::mutex> lock(_mutex);
+    _allDone.wait(lock, [this] { return _unfinished.load() == 0; });
+}
+
+void WorkStealingPool::workerLoop(unsigned int index) {
+    for (;;) {
+        Task task;
+        if (popLocal(index, task) || steal(index, task)) {
+            _queued.fetch_sub(1);
+            task(index);
+            if (_unfinished.fetch_sub(1) == 1) {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _allDone.notify_all();
+            }
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(_mutex);
+        _workReady.wait(lock, [this] { return _stop || _queued.load() > 0; });
+        if (_stop && _queued.load() == 0) return;
+    }
+}
+
+bool WorkStealingPool::popLocal(unsigned int index, Task& task) {
+    WorkQueue& queue = *_queues[index];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty()) return false;
+    task = std::move(queue.tasks.back());
+    queue.tasks.pop_back();
+    return true;
+}
+
+bool WorkStealingPool::steal(unsigned int thief, Task& task) {
+    for (size_t i = 1; i < _queues.size(); ++i) {
+        WorkQueue& queue = *_queues[(thief + i) % _queues.size()];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.tasks.empty()) continue;
+        task = std::move(queue.tasks.front());
+        queue.tasks.pop_front();
+        return true;
+    }
+    return false;
+}
@@ -0,0 +1,56 @@
+// Work-stealing thread pool for the batch tools: one deque per worker, owners pop the back,
+// idle workers steal from the front of the others; tasks get the worker index for per-worker state
+// 2026.10.17 by BillyDu
+#ifndef __WORK_STEALING_POOL_H__
+#define __WORK_STEALING_POOL_H__
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class WorkStealingPool {
+public:
+    using Task = std::function<void(unsigned int worker)>;
+
+    // 0 = one worker per hardware thread
+    explicit WorkStealingPool(unsigned int threads = 0);
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    // Tasks are dealt round-robin over the worker queues; safe to call from inside a task
+    void submit(Task task);
+    // Blocks until every submitted task has finished
+    void wait();
+
+    unsigned int getThreadCount() const { return (unsigned int)_threads.size(); }
+
+private:
+    struct WorkQueue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    void workerLoop(unsigned int index);
+    bool popLocal(unsigned int index, Task& task);
+    bool steal(unsigned int thief, Task& task);
+
+    std::vector<std::unique_ptr<WorkQueue>> _queues;
+    std::vector<std::thread> _threads;
+
+    std::mutex _mutex;                    // guards the sleeping / waiting condition variables
+    std::condition_variable _workReady;
+    std::condition_variable _allDone;
+    std::atomic<size_t> _queued{ 0 };     // tasks sitting in a queue
+    std::atomic<size_t> _unfinished{ 0 }; // submitted and not finished yet
+    std::atomic<unsigned int> _nextQueue{ 0 };
+    bool _stop = false;
+};
+
+#endif // __WORK_STEALING_POOL_H__
@@ -0,0 +1,93 @@
+// PvzRun: headless level runner, plays a level as fast as the CPU allows
+//   PvzRun --level data/level_map2.json --plants 1001,1002,1008 [--seed N] [--script placements.json]
+//          [--headless] [--max-speed] [--auto] [--data <dir>] [--map N] [--sun N] [--max-time <seconds>]
+// Exit code: 0 victory, 1 game over / time limit, 2 bad arguments or data
+// 2026.10.17 by BillyDu
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+#include "LevelRunner.h"
+
+static void printUsage() {
+    fprintf(stderr,
+            "usage: PvzRun --level <file> --plants <id,id,...> [--seed N] [--script <file>]\n"
+            "              [--headless] [--max-speed] [--auto] [--data <dir>] [--map N] [--sun N]\n"
+            "              [--max-time <seconds>]\n"
+            "  --headless   no window (always on, accepted for symmetry with the game binary)\n"
+            "  --max-speed  simulate as fast as possible instead of in real time\n"
+            "  --auto       let the seeded AutoPlayer play the loadout once the script is done\n"
+            "  --data       directory with plants.json / zombies.json (default: the level's directory)\n"
+            "  --map        map ID for the lawn layout (default: from the level file name)\n");
+}
+
+int main(int argc, char** argv) {
+    RunOptions options;
+    std::string levelPath;
+    std::string scriptPath;
+    std::string dataDir;
+    int mapId = 0;
+    options.maxSpeed = false; // real time unless --max-speed
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--level" && hasValue) levelPath = argv[++i];
+        else if (arg == "--plants" && hasValue) {
+            if (!LevelRunner::parseIdList(argv[++i], options.loadout)) {
+                fprintf(stderr, "[Err] Bad plant list: %s\n", argv[i]);
+                return 2;
+            }
+        }
+        else if (arg == "--seed" && hasValue) options.seed = (unsigned int)strtoul(argv[++i], nullptr, 10);
+        else if (arg == "--script" && hasValue) scriptPath = argv[++i];
+        else if (arg == "--data" && hasValue) dataDir = argv[++i];
+        else if (arg == "--map" && hasValue) mapId = atoi(argv[++i]);
+        else if (arg == "--sun" && hasValue) options.initialSun = atoi(argv[++i]);
+        else if (arg == "--max-time" && hasValue) options.maxSimSeconds = (float)atof(argv[++i]);
+        else if (arg == "--headless") {}
+        else if (arg == "--max-speed") options.maxSpeed = true;
+        else if (arg == "--auto") options.autoPlay = true;
+        else {
+            printUsage();
+            return 2;
+        }
+    }
+    if (levelPath.empty() || options.loadout.empty()) {
+        printUsage();
+        return 2;
+    }
+    if (dataDir.empty()) {
+        size_t slash = levelPath.find_last_of("/\\");
+        dataDir = (slash == std::string::npos) ? "." : levelPath.substr(0, slash);
+    }
+    options.mapId = mapId > 0 ? mapId : LevelRunner::mapIdFromLevelPath(levelPath);
+
+    LevelRunner runner;
+    std::string error;
+    if (!runner.loadData(dataDir, levelPath, options.mapId, error) ||
+        (!scriptPath.empty() && !LevelRunner::loadScript(scriptPath, options.script, error))) {
+        fprintf(stderr, "[Err] %s\n", error.c_str());
+        return 2;
+    }
+
+    for (const auto& action : options.script) {
+        if (action.kind == ScriptAction::Kind::PLANT &&
+            std::find(options.loadout.begin(), options.loadout.end(), action.plantId) == options.loadout.end()) {
+            fprintf(stderr, "[Warn] Script plants %d, which is not in --plants; the script will stall there\n",
+                    action.plantId);
+        }
+    }
+
+    RunResult r = runner.run(options);
+
+    printf("outcome:   %s\n", LevelRunner::outcomeName(r.state));
+    printf("sim time:  %.2f s\n", r.simSeconds);
+    printf("wall time: %.3f ms\n", r.wallSeconds * 1000.0);
+    printf("ticks:     %llu (%.0f ticks/s)\n", r.ticks, r.wallSeconds > 0.0 ? r.ticks / r.wallSeconds : 0.0);
+    if (r.actionsTotal > 0) {
+        printf("script:    %zu/%zu actions done\n", r.actionsDone, r.actionsTotal);
+    }
+    return r.state == GameState::VICTORY ? 0 : 1;
+}
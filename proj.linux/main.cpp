@@ -23,16 +23,25 @@
  ****************************************************************************/
 
 #include "../Classes/AppDelegate.h"
+#include "../Classes/Sim/TraceWriter.h"
 
 #include <stdlib.h>
 #include <stdio.h>
 #include <unistd.h>
 #include <string>
+#include <string.h>
 
 USING_NS_CC;
 
 int main(int argc, char **argv)
 {
+    // --trace <file>: write a Chrome trace (same as PVZ_TRACE=<file>)
+    for (int i = 1; i + 1 < argc; ++i) {
+        if (strcmp(argv[i], "--trace") == 0) {
+            TraceWriter::getInstance().start(argv[i + 1]);
+        }
+    }
+
     // create the application instance
     AppDelegate app;
     return Application::getInstance()->run();